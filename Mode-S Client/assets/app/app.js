@@ -104,8 +104,10 @@ function setActionBusy(button, busy, busyText){
   button.textContent = busy ? (busyText || "Working...") : button.dataset.label;
 }
 
-async function apiGet(url){
-  const r = await fetch(url, {cache:"no-store"});
+// Pass cache:"no-cache" only for endpoints that send an ETag (ServeCachedJson); the browser then
+// keeps the body and revalidates. Everything else stays uncached.
+async function apiGet(url, cache = "no-store"){
+  const r = await fetch(url, {cache});
   if (!r.ok) throw new Error(`${r.status} ${r.statusText}`);
   return await r.json();
 }
@@ -506,9 +508,30 @@ function applyMetrics(m){
   }
 }
 
+// Metrics push via /api/stream (SSE). Frames carry only changed keys, so merge into the last snapshot.
+let _metricsStreamOpen = false;
+let _metricsSnapshot = null;
+function startMetricsStream(){
+  if (typeof EventSource === "undefined") return;
+  const es = new EventSource("/api/stream?topics=metrics");
+  es.onopen = () => { _metricsStreamOpen = true; };
+  es.onerror = () => { _metricsStreamOpen = false; };
+  es.addEventListener("metrics", (msg) => {
+    try{
+      const delta = JSON.parse(msg.data);
+      _metricsSnapshot = Object.assign(_metricsSnapshot || {}, delta);
+      applyMetrics(_metricsSnapshot);
+    }catch(e){
+      console.debug("metrics stream frame failed", e);
+    }
+  });
+}
+
 async function pollMetrics(){
+  if (_metricsStreamOpen) return;
   try{
-    const m = await apiGet("/api/metrics");
+    const m = await apiGet("/api/metrics", "no-cache");
+    _metricsSnapshot = m;
     applyMetrics(m);
   }catch(e){
     // avoid spamming
@@ -820,7 +843,7 @@ async function pollHomePlatformStatus(){
   if (!isHomePage()) return;
 
   try {
-    const status = await apiGet("/api/platform/status");
+    const status = await apiGet("/api/platform/status", "no-cache");
     HOME_PLATFORMS.forEach((platform) => {
       const node = status?.[platform];
       if (node && typeof node === "object") {
@@ -1020,7 +1043,7 @@ async function loadHomeAlertsHistory(options = {}){
   }
 
   try {
-    const payload = await apiGet("/api/alerts/history?limit=200");
+    const payload = await apiGet("/api/alerts/history?limit=200", "no-cache");
     homeAlertsState.events = homeAlertEventsFromPayload(payload);
     homeAlertsState.total = homeAlertsState.events.length;
     const totalPages = Math.max(1, Math.ceil(homeAlertsState.total / HOME_ALERTS_PAGE_SIZE));
@@ -2033,6 +2056,7 @@ document.addEventListener("DOMContentLoaded", async () => {
     });
   });
 
+  startMetricsStream();
   setInterval(pollMetrics, 2000);
   if (isHomePage()) {
     setInterval(fetchHomeAuthStatuses, 15000);
@@ -2095,7 +2119,7 @@ function wireOverlayTitlePage() {
   async function load() {
     setStatus("Loading…");
     try {
-      const j = await apiGet("/api/overlay/header");
+      const j = await apiGet("/api/overlay/header", "no-cache");
 
       elTitle.value = (j && typeof j.title === "string") ? j.title : "";
       elSub.value = (j && typeof j.subtitle === "string") ? j.subtitle : "";
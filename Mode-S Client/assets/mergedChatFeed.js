@@ -140,10 +140,38 @@
     function start(cfg) {
         if (!cfg) throw new Error("MergedChatFeed.start: missing cfg");
         const intervalMs = cfg.intervalMs || 1000;
-        const run = () => tick(cfg);
+
+        // Optional push wake-up: when cfg.streamUrl (/api/stream) is connected, ticks run on
+        // "chat"/"alert" events and the interval only acts as a slow safety net.
+        const streamFallbackMs = cfg.streamFallbackMs || 10000;
+        let streamOpen = false;
+        let lastRun = 0;
+        let kickQueued = false;
+
+        const run = () => { lastRun = Date.now(); return tick(cfg); };
+        const poll = () => {
+            if (streamOpen && (Date.now() - lastRun) < streamFallbackMs) return;
+            run();
+        };
+
+        if (cfg.streamUrl && typeof EventSource !== "undefined") {
+            const es = new EventSource(cfg.streamUrl);
+            const kick = () => {
+                if (kickQueued) return;
+                kickQueued = true;
+                // Coalesce bursts into a single fetch.
+                setTimeout(() => { kickQueued = false; run(); }, 50);
+            };
+            es.onopen = () => { streamOpen = true; };
+            es.onerror = () => { streamOpen = false; };
+            es.addEventListener("chat", kick);
+            es.addEventListener("alert", kick);
+            es.addEventListener("resync", kick);
+        }
+
         // run immediately
         run();
-        return setInterval(run, intervalMs);
+        return setInterval(poll, intervalMs);
     }
 
     window.MergedChatFeed = { start };
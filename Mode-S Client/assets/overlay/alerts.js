@@ -2,7 +2,7 @@
   ATC Alerts Overlay (Twitch + TikTok)
 
   Served via: http://localhost:17845/overlay/alerts.html
-  Polls:
+  Listens on /api/stream?topics=alerts (SSE) and polls as a fallback:
     - /api/twitch/eventsub/events
     - /api/tiktok/events  (also tries /api/TikTok/events)
 
@@ -15,6 +15,8 @@
 (() => {
     const CONFIG = {
         pollMs: 450,
+        streamUrl: '/api/stream?topics=alerts',
+        streamFallbackMs: 10000,
         queueMax: 25,
         dedupeMax: 1500,
         // enter (320) + hold (3600) + exit (420) + gap (260)
@@ -48,6 +50,7 @@
     let playing = false;
     let lastPollOk = 0;
     let lastPollErr = '';
+    let streamOpen = false;
 
     const isDebug = new URLSearchParams(location.search).has('debug');
     if (isDebug) document.body.classList.add('debug');
@@ -494,7 +497,7 @@
     }
 
     async function fetchJson(url) {
-        const r = await fetch(url, { cache: 'no-store' });
+        const r = await fetch(url, { cache: 'no-cache' });
         if (!r.ok) throw new Error(`${r.status} ${r.statusText}`);
         return await r.json();
     }
@@ -513,7 +516,22 @@
         debugText.textContent = `q=${q} • last_ok=${age} • ${cuts}${lastPollErr ? ` • err=${lastPollErr}` : ''}`;
     }
 
+    function acceptEvent(e) {
+        if (!shouldAcceptEvent(e)) return;
+
+        const key = eventKey(e);
+        if (!key) return;
+        if (seen.has(key)) return;
+
+        seen.set(key, nowMs());
+        enqueue(e);
+        markAcceptedEvent(e);
+    }
+
     async function pollOnce() {
+        // While the push stream is connected, polling is only a slow safety net.
+        if (streamOpen && (nowMs() - lastPollOk) < CONFIG.streamFallbackMs) return;
+
         let anyOk = false;
         let errMsg = '';
 
@@ -524,17 +542,7 @@
                     ? data.events
                     : (Array.isArray(data?.events?.events) ? data.events.events : []);
 
-                for (const e of events) {
-                    if (!shouldAcceptEvent(e)) continue;
-
-                    const key = eventKey(e);
-                    if (!key) continue;
-                    if (seen.has(key)) continue;
-
-                    seen.set(key, nowMs());
-                    enqueue(e);
-                    markAcceptedEvent(e);
-                }
+                for (const e of events) acceptEvent(e);
 
                 pruneSeen();
                 anyOk = true;
@@ -639,7 +647,29 @@
         };
     }
 
+    // Push stream: alerts arrive as soon as the backend records them.
+    function startStream() {
+        if (typeof EventSource === 'undefined') return;
+        const es = new EventSource(CONFIG.streamUrl);
+        es.onopen = () => { streamOpen = true; };
+        es.onerror = () => { streamOpen = false; };
+        es.addEventListener('alert', (msg) => {
+            try {
+                acceptEvent(JSON.parse(msg.data));
+                pruneSeen();
+                lastPollOk = nowMs();
+                updateDebug();
+                if (!playing) playNext();
+            } catch (err) {
+                console.debug('[alerts] bad stream frame', err);
+            }
+        });
+        // Missed frames: fall back to one full poll.
+        es.addEventListener('resync', () => { lastPollOk = 0; pollOnce(); });
+    }
+
     // Kick off
+    startStream();
     setInterval(pollOnce, CONFIG.pollMs);
     pollOnce();
 })();
\ No newline at end of file
@@ -0,0 +1,249 @@
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+
+#include "EuroScopeBinaryListener.h"
+
+#include <cstring>
+#include <vector>
+
+#include "json.hpp"
+#include "EuroScopeIngestService.h"
+#include "core/StringUtil.h"
+
+#pragma comment(lib, "ws2_32.lib")
+
+namespace {
+
+constexpr size_t kHeaderBytes = 5;
+constexpr size_t kRecvChunk = 64 * 1024;
+constexpr long kPollUs = 250 * 1000; // how quickly Stop() is noticed
+
+// Waits until `s` is readable (or accept-able); false on timeout or error.
+bool WaitReadable(SOCKET s)
+{
+    fd_set rd;
+    FD_ZERO(&rd);
+    FD_SET(s, &rd);
+    timeval tv{ 0, kPollUs };
+    return select(0, &rd, nullptr, nullptr, &tv) > 0;
+}
+
+uint32_t ReadBe32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+// SAX pass that only tracks nesting. from_msgpack/from_cbor recurse once per level, so a frame of
+// nested array headers would overflow the stack before any exception could be thrown; the
+// reader stops as soon as start_* returns false, which bounds the recursion here too.
+class DepthCheck : public nlohmann::json_sax<nlohmann::json>
+{
+public:
+    bool null() override { return true; }
+    bool boolean(bool) override { return true; }
+    bool number_integer(number_integer_t) override { return true; }
+    bool number_unsigned(number_unsigned_t) override { return true; }
+    bool number_float(number_float_t, const string_t&) override { return true; }
+    bool string(string_t&) override { return true; }
+    bool binary(binary_t&) override { return true; }
+    bool key(string_t&) override { return true; }
+    bool start_object(std::size_t) override { return Enter(); }
+    bool end_object() override { --depth_; return true; }
+    bool start_array(std::size_t) override { return Enter(); }
+    bool end_array() override { --depth_; return true; }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override
+    {
+        error = e.what();
+        return false;
+    }
+
+    std::string error;
+
+private:
+    bool Enter()
+    {
+        if (++depth_ <= EuroScopeBinaryListener::kMaxDepth) return true;
+        error = "nesting deeper than " + std::to_string(EuroScopeBinaryListener::kMaxDepth);
+        return false;
+    }
+
+    int depth_ = 0;
+};
+
+} // namespace
+
+EuroScopeBinaryListener::~EuroScopeBinaryListener()
+{
+    Stop();
+}
+
+bool EuroScopeBinaryListener::Start(EuroScopeIngestService& ingest, LogFn log, uint16_t port)
+{
+    Stop();
+
+    ingest_ = &ingest;
+    log_ = std::move(log);
+
+    WSADATA wsa{};
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) {
+        Log(L"EuroScope binary ingest: WSAStartup failed");
+        return false;
+    }
+    wsa_started_ = true;
+
+    SOCKET s = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (s == INVALID_SOCKET) {
+        Log(L"EuroScope binary ingest: socket() failed (" + std::to_wstring(WSAGetLastError()) + L")");
+        Stop();
+        return false;
+    }
+
+    BOOL exclusive = TRUE;
+    setsockopt(s, SOL_SOCKET, SO_EXCLUSIVEADDRUSE, (const char*)&exclusive, sizeof(exclusive));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(s, (const sockaddr*)&addr, sizeof(addr)) == SOCKET_ERROR || listen(s, 1) == SOCKET_ERROR) {
+        Log(L"EuroScope binary ingest: cannot listen on 127.0.0.1:" + std::to_wstring(port) +
+            L" (" + std::to_wstring(WSAGetLastError()) + L"); JSON ingest only");
+        closesocket(s);
+        Stop();
+        return false;
+    }
+
+    listen_sock_ = (std::uintptr_t)s;
+    running_.store(true);
+    worker_ = std::thread(&EuroScopeBinaryListener::AcceptLoop, this);
+    Log(L"EuroScope binary ingest: listening on 127.0.0.1:" + std::to_wstring(port));
+    return true;
+}
+
+void EuroScopeBinaryListener::Stop()
+{
+    running_.store(false);
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+
+    if ((SOCKET)listen_sock_ != INVALID_SOCKET) {
+        closesocket((SOCKET)listen_sock_);
+        listen_sock_ = (std::uintptr_t)INVALID_SOCKET;
+    }
+    if (wsa_started_) {
+        WSACleanup();
+        wsa_started_ = false;
+    }
+}
+
+void EuroScopeBinaryListener::AcceptLoop()
+{
+    const SOCKET ls = (SOCKET)listen_sock_;
+    while (running_.load()) {
+        if (!WaitReadable(ls)) continue;
+
+        SOCKET client = accept(ls, nullptr, nullptr);
+        if (client == INVALID_SOCKET) continue;
+
+        ServeClient((std::uintptr_t)client);
+        closesocket(client);
+    }
+}
+
+void EuroScopeBinaryListener::ServeClient(std::uintptr_t client)
+{
+    const SOCKET s = (SOCKET)client;
+    Log(L"EuroScope binary ingest: plugin connected");
+
+    // Bytes received but not yet consumed as whole frames live in buf[0, have).
+    std::vector<uint8_t> buf(kRecvChunk);
+    size_t have = 0;
+    uint64_t frames = 0;
+    uint64_t rejected = 0;
+    std::wstring reason = L"closed by plugin";
+
+    while (running_.load()) {
+        if (!WaitReadable(s)) continue;
+
+        if (buf.size() - have < kRecvChunk) buf.resize(have + kRecvChunk);
+        const int n = recv(s, (char*)buf.data() + have, (int)(buf.size() - have), 0);
+        if (n == 0) break;
+        if (n < 0) {
+            reason = L"recv error " + std::to_wstring(WSAGetLastError());
+            break;
+        }
+        have += (size_t)n;
+
+        size_t off = 0;
+        bool drop = false;
+        while (have - off >= kHeaderBytes) {
+            const uint32_t len = ReadBe32(buf.data() + off);
+            const uint8_t format = buf[off + 4];
+            if (len > kMaxFrameBytes || (format != kFormatMsgPack && format != kFormatCbor)) {
+                reason = L"bad frame header (length " + std::to_wstring(len) +
+                    L", format " + std::to_wstring(format) + L")";
+                drop = true;
+                break;
+            }
+            if (have - off < kHeaderBytes + len) break;
+
+            std::string err;
+            if (HandleFrame(format, buf.data() + off + kHeaderBytes, len, err)) {
+                ++frames;
+            }
+            else if (rejected++ == 0) {
+                // Log the first rejection only; a plugin bug would otherwise flood the log at 10 Hz.
+                Log(L"EuroScope binary ingest: frame rejected: " + ToW(err));
+            }
+            off += kHeaderBytes + len;
+        }
+        if (drop) break;
+
+        if (off > 0) {
+            std::memmove(buf.data(), buf.data() + off, have - off);
+            have -= off;
+        }
+        // Keep the steady-state buffer small after one large frame.
+        if (have < kRecvChunk && buf.size() > 4 * kRecvChunk) buf.resize(kRecvChunk);
+    }
+
+    if (!running_.load()) reason = L"shutting down";
+    Log(L"EuroScope binary ingest: plugin disconnected (" + reason + L"; " + std::to_wstring(frames) +
+        L" frames, " + std::to_wstring(rejected) + L" rejected)");
+}
+
+bool EuroScopeBinaryListener::HandleFrame(uint8_t format, const uint8_t* data, size_t len, std::string& err)
+{
+    try {
+        const auto input_format = format == kFormatCbor
+            ? nlohmann::json::input_format_t::cbor
+            : nlohmann::json::input_format_t::msgpack;
+        DepthCheck check;
+        if (!nlohmann::json::sax_parse(data, data + len, &check, input_format)) {
+            err = check.error.empty() ? "malformed frame" : check.error;
+            return false;
+        }
+
+        nlohmann::json msg = format == kFormatCbor
+            ? nlohmann::json::from_cbor(data, data + len)
+            : nlohmann::json::from_msgpack(data, data + len);
+        return ingest_->IngestMessage(std::move(msg), err);
+    }
+    catch (const std::exception& e) {
+        err = e.what();
+        return false;
+    }
+    catch (...) {
+        err = "unknown decode error";
+        return false;
+    }
+}
+
+void EuroScopeBinaryListener::Log(const std::wstring& s) const
+{
+    if (log_) log_(s);
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+class EuroScopeIngestService;
+
+// Persistent localhost TCP ingest channel for the EuroScope plugin, next to the JSON
+// POST /api/euroscope path. The plugin keeps one connection open and streams frames:
+//
+//   [u32 length, big-endian] [u8 format] [length bytes of payload]
+//
+// format 1 = MessagePack, 2 = CBOR. The decoded payload is the same object the HTTP path takes
+// (snapshot or delta, see EuroScopeTrafficStore) and goes through IngestMessage(), so there is
+// no per-update connect, HTTP parse or JSON text parse.
+//
+// One client is served at a time; a second connection waits in the backlog until the first
+// closes. A frame that fails to decode (including one nested deeper than kMaxDepth, rejected
+// before the recursive decoder sees it) or to ingest is skipped; an oversized or unknown-format
+// frame drops the connection, since the stream can no longer be trusted to be in sync.
+class EuroScopeBinaryListener
+{
+public:
+    using LogFn = std::function<void(const std::wstring&)>;
+
+    static constexpr uint16_t kDefaultPort = 17846;
+    static constexpr uint32_t kMaxFrameBytes = 1024 * 1024; // a full sector snapshot is a few hundred KB
+    static constexpr int kMaxDepth = 64;
+    static constexpr uint8_t kFormatMsgPack = 1;
+    static constexpr uint8_t kFormatCbor = 2;
+
+    EuroScopeBinaryListener() = default;
+    ~EuroScopeBinaryListener();
+
+    EuroScopeBinaryListener(const EuroScopeBinaryListener&) = delete;
+    EuroScopeBinaryListener& operator=(const EuroScopeBinaryListener&) = delete;
+
+    // Binds 127.0.0.1:port and starts the listener thread. Returns false (and logs) when the
+    // port is unavailable; the HTTP ingest path keeps working either way.
+    bool Start(EuroScopeIngestService& ingest, LogFn log, uint16_t port = kDefaultPort);
+    void Stop();
+
+    bool running() const { return running_.load(); }
+
+private:
+    void AcceptLoop();
+    void ServeClient(std::uintptr_t client);
+
+    // Decodes and ingests one frame payload; false when it was rejected.
+    bool HandleFrame(uint8_t format, const uint8_t* data, size_t len, std::string& err);
+
+    void Log(const std::wstring& s) const;
+
+    EuroScopeIngestService* ingest_ = nullptr;
+    LogFn log_;
+
+    std::atomic<bool> running_{ false };
+    std::uintptr_t listen_sock_ = ~(std::uintptr_t)0; // SOCKET, INVALID_SOCKET when closed
+    bool wsa_started_ = false;
+    std::thread worker_;
+};
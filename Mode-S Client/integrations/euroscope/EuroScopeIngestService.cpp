@@ -3,9 +3,22 @@
 bool EuroScopeIngestService::Ingest(std::string_view body, std::string& err)
 {
     try {
-        auto j = nlohmann::json::parse(body.begin(), body.end());
+        return IngestMessage(nlohmann::json::parse(body.begin(), body.end()), err);
+    }
+    catch (const std::exception& e) {
+        err = e.what();
+        return false;
+    }
+    catch (...) {
+        err = "unknown parse error";
+        return false;
+    }
+}
 
-        if (!j.contains("ts_ms") || !j["ts_ms"].is_number_unsigned()) {
+bool EuroScopeIngestService::IngestMessage(nlohmann::json j, std::string& err)
+{
+    try {
+        if (!j.is_object() || !j.contains("ts_ms") || !j["ts_ms"].is_number_unsigned()) {
             err = "missing ts_ms";
             return false;
         }
@@ -14,9 +27,12 @@ bool EuroScopeIngestService::Ingest(std::string_view body, std::string& err)
 
         {
             std::lock_guard<std::mutex> lk(mtx_);
-            last_payload_ = std::move(j);
+            if (!traffic_.Apply(std::move(j), ts_ms, err)) return false;
             last_ts_ms_ = ts_ms;
+            last_ingest_at_ = std::chrono::steady_clock::now();
+            expired_idle_ms_ = 0;
         }
+        version_.fetch_add(1, std::memory_order_acq_rel);
 
         return true;
     }
@@ -25,11 +41,29 @@ bool EuroScopeIngestService::Ingest(std::string_view body, std::string& err)
         return false;
     }
     catch (...) {
-        err = "unknown parse error";
+        err = "unknown ingest error";
         return false;
     }
 }
 
+void EuroScopeIngestService::Expire()
+{
+    bool changed = false;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (last_ts_ms_ == 0) return;
+
+        const uint64_t idle_ms = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - last_ingest_at_).count();
+        // While the plugin is sending, Apply() already evicts.
+        if (idle_ms < FRESH_MS || idle_ms < expired_idle_ms_ + 1000) return;
+
+        expired_idle_ms_ = idle_ms;
+        changed = traffic_.Expire(last_ts_ms_ + idle_ms);
+    }
+    if (changed) version_.fetch_add(1, std::memory_order_acq_rel);
+}
+
 nlohmann::json EuroScopeIngestService::Metrics(uint64_t now_ms) const
 {
     nlohmann::json payload;
@@ -37,18 +71,56 @@ nlohmann::json EuroScopeIngestService::Metrics(uint64_t now_ms) const
 
     {
         std::lock_guard<std::mutex> lk(mtx_);
-        payload = last_payload_;
+        payload = traffic_.SummaryJson();
         ts = last_ts_ms_;
     }
 
-    const bool connected =
-        (ts != 0) &&
-        (now_ms >= ts) &&
-        ((now_ms - ts) <= FRESH_MS);
-
     return nlohmann::json{
         { "euroscope", std::move(payload) },
         { "euroscope_ts_ms", ts },
-        { "euroscope_connected", connected }
+        { "euroscope_connected", IsFresh(ts, now_ms) }
     };
 }
+
+std::string EuroScopeIngestService::TrafficJson() const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    return traffic_.ViewJson();
+}
+
+nlohmann::json EuroScopeIngestService::NearbyJson(double lat, double lon, double radius_nm, int limit) const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    return traffic_.NearbyJson(lat, lon, radius_nm, limit);
+}
+
+nlohmann::json EuroScopeIngestService::TrailsJson(uint64_t since_ms) const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    return traffic_.trails().Json(since_ms);
+}
+
+std::string EuroScopeIngestService::TrailsBinary(uint64_t since_ms) const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    return traffic_.trails().Binary(since_ms);
+}
+
+bool EuroScopeIngestService::FieldPosition(double& lat, double& lon) const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    return traffic_.FieldPosition(lat, lon);
+}
+
+bool EuroScopeIngestService::Connected(uint64_t now_ms) const
+{
+    std::lock_guard<std::mutex> lk(mtx_);
+    return IsFresh(last_ts_ms_, now_ms);
+}
+
+bool EuroScopeIngestService::IsFresh(uint64_t ts, uint64_t now_ms)
+{
+    return (ts != 0) &&
+        (now_ms >= ts) &&
+        ((now_ms - ts) <= FRESH_MS);
+}
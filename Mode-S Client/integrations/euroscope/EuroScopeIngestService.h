@@ -1,25 +1,64 @@
 #pragma once
+#include <atomic>
+#include <chrono>
 #include <mutex>
 #include <string>
 #include <string_view>
 #include <cstdint>
 #include "json.hpp"
+#include "EuroScopeTrafficStore.h"
 
 // Owns EuroScope ingest state and exposes a small JSON merge payload for /api/metrics.
 class EuroScopeIngestService {
 public:
-    // Ingest raw JSON POST body from EuroScope plugin.
-    // Requires "ts_ms" (epoch ms) so Mode-S Client can calculate freshness.
+    // Ingest raw JSON POST body from EuroScope plugin: a full snapshot or a per-aircraft delta
+    // (see EuroScopeTrafficStore). Requires "ts_ms" (epoch ms) so Mode-S Client can calculate
+    // freshness. IngestMessage takes a message already decoded by another transport.
     bool Ingest(std::string_view body, std::string& err);
+    bool IngestMessage(nlohmann::json msg, std::string& err);
 
     // Returns an object suitable for j.update(...):
     //  { "euroscope": {...}, "euroscope_ts_ms": <uint64>, "euroscope_connected": <bool> }
+    // "euroscope" holds the sector summary and aircraft_count; the aircraft themselves are only
+    // in TrafficJson().
     nlohmann::json Metrics(uint64_t now_ms) const;
 
+    // Serialized /api/euroscope/traffic body (summary + aircraft), cached between changes.
+    std::string TrafficJson() const;
+
+    // /api/euroscope/traffic/nearby body: aircraft within radius_nm of (lat, lon), nearest first.
+    nlohmann::json NearbyJson(double lat, double lon, double radius_nm, int limit) const;
+
+    // /api/euroscope/trails: position history newer than since_ms (see EuroScopeTrailStore),
+    // as JSON columns or the compact binary layout.
+    nlohmann::json TrailsJson(uint64_t since_ms) const;
+    std::string TrailsBinary(uint64_t since_ms) const;
+
+    // Sector airport position (summary airport_lat/airport_lon), the default nearby centre.
+    bool FieldPosition(double& lat, double& lon) const;
+
+    // Bumped after every successful ingest and every Expire() that dropped something
+    // (HTTP response cache / ETag).
+    uint64_t Version() const { return version_.load(std::memory_order_acquire); }
+
+    // Apply() only evicts against message time, so once the plugin stops sending the last
+    // picture would stay forever. Projects the plugin clock forward by the wall-clock time since
+    // the last ingest and evicts against that (at most once a second). Readers call it before
+    // Version().
+    void Expire();
+
+    // True while the last ingest is younger than FRESH_MS.
+    bool Connected(uint64_t now_ms) const;
+
 private:
+    static bool IsFresh(uint64_t ts, uint64_t now_ms);
+
     mutable std::mutex mtx_;
-    nlohmann::json last_payload_ = nlohmann::json::object();
+    EuroScopeTrafficStore traffic_;
     uint64_t last_ts_ms_ = 0;
+    std::chrono::steady_clock::time_point last_ingest_at_{};
+    uint64_t expired_idle_ms_ = 0; // idle time of the last Expire() pass since that ingest
+    std::atomic<uint64_t> version_{ 0 };
 
     static constexpr uint64_t FRESH_MS = 5000;
 };
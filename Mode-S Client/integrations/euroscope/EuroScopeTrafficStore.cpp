@@ -0,0 +1,431 @@
+#include "EuroScopeTrafficStore.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kEarthRadiusNm = 3440.065;
+constexpr int kGridRows = (int)(180.0 / EuroScopeTrafficStore::kCellDeg);
+constexpr int kGridCols = (int)(360.0 / EuroScopeTrafficStore::kCellDeg);
+
+double Rad(double deg) { return deg * kPi / 180.0; }
+
+int GridRow(double lat)
+{
+    return std::clamp((int)std::floor((lat + 90.0) / EuroScopeTrafficStore::kCellDeg), 0, kGridRows - 1);
+}
+
+int GridCol(double lon)
+{
+    const int c = (int)std::floor((lon + 180.0) / EuroScopeTrafficStore::kCellDeg);
+    return ((c % kGridCols) + kGridCols) % kGridCols;
+}
+
+// Great-circle distance (haversine) and initial bearing.
+double DistanceNm(double lat1, double lon1, double lat2, double lon2)
+{
+    const double dlat = Rad(lat2 - lat1);
+    const double dlon = Rad(lon2 - lon1);
+    const double a = std::sin(dlat / 2) * std::sin(dlat / 2) +
+        std::cos(Rad(lat1)) * std::cos(Rad(lat2)) * std::sin(dlon / 2) * std::sin(dlon / 2);
+    return 2.0 * kEarthRadiusNm * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+double BearingDeg(double lat1, double lon1, double lat2, double lon2)
+{
+    const double dlon = Rad(lon2 - lon1);
+    const double y = std::sin(dlon) * std::cos(Rad(lat2));
+    const double x = std::cos(Rad(lat1)) * std::sin(Rad(lat2)) -
+        std::sin(Rad(lat1)) * std::cos(Rad(lat2)) * std::cos(dlon);
+    const double deg = std::atan2(y, x) * 180.0 / kPi;
+    return std::fmod(deg + 360.0, 360.0);
+}
+
+double Round2(double v) { return std::round(v * 100.0) / 100.0; }
+
+bool ReadPosition(const nlohmann::json& rec, double& lat, double& lon)
+{
+    auto la = rec.find("lat");
+    auto lo = rec.find("lon");
+    if (la == rec.end() || lo == rec.end() || !la->is_number() || !lo->is_number()) return false;
+    lat = la->get<double>();
+    lon = lo->get<double>();
+    return std::isfinite(lat) && std::isfinite(lon) && lat >= -90.0 && lat <= 90.0 && lon >= -180.0 && lon <= 180.0;
+}
+
+std::string Dump(const nlohmann::json& j)
+{
+    return j.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+// Message keys that are not summary fields.
+bool IsReservedKey(const std::string& k)
+{
+    return k == "ts_ms" || k == "delta" || k == "aircraft" || k == "removed" || k == "aircraft_count";
+}
+
+} // namespace
+
+bool EuroScopeTrafficStore::Apply(nlohmann::json msg, uint64_t ts_ms, std::string& err)
+{
+    if (!msg.is_object()) {
+        err = "payload must be an object";
+        return false;
+    }
+
+    bool delta = false;
+    if (auto it = msg.find("delta"); it != msg.end()) {
+        if (!it->is_boolean()) {
+            err = "delta must be a boolean";
+            return false;
+        }
+        delta = it->get<bool>();
+    }
+
+    nlohmann::json aircraft = nlohmann::json::array();
+    if (auto it = msg.find("aircraft"); it != msg.end()) {
+        if (!it->is_array()) {
+            err = "aircraft must be an array";
+            return false;
+        }
+        aircraft = std::move(*it);
+    }
+
+    nlohmann::json removed = nlohmann::json::array();
+    if (auto it = msg.find("removed"); it != msg.end()) {
+        if (!it->is_array()) {
+            err = "removed must be an array";
+            return false;
+        }
+        removed = std::move(*it);
+    }
+
+    // The plugin clock went backwards (EuroScope restart): bring everything stamped by the old
+    // clock onto the new one before any staleness check compares against it.
+    if (ts_ms < ts_ms_) Rewind(ts_ms);
+
+    for (auto it = msg.begin(); it != msg.end();) {
+        if (IsReservedKey(it.key())) it = msg.erase(it);
+        else ++it;
+    }
+
+    // Summary: a snapshot replaces it; a delta replaces the top-level fields it names
+    // (null removes one).
+    if (!delta) {
+        summary_ = std::move(msg);
+        summary_dirty_ = true;
+    }
+    else if (!msg.empty()) {
+        for (auto it = msg.begin(); it != msg.end(); ++it) {
+            if (it->is_null()) summary_.erase(it.key());
+            else summary_[it.key()] = std::move(it.value());
+        }
+        summary_dirty_ = true;
+    }
+
+    ++gen_;
+    for (const auto& rec : aircraft) {
+        Upsert(rec, ts_ms, delta);
+    }
+
+    if (!delta) {
+        // Anything the snapshot did not name has left the sector.
+        for (auto it = aircraft_.begin(); it != aircraft_.end();) {
+            if (it->second.gen != gen_) it = Erase(it);
+            else ++it;
+        }
+    }
+
+    for (const auto& cs : removed) {
+        if (cs.is_string()) Remove(cs.get<std::string>());
+    }
+
+    EvictStale(ts_ms);
+    trails_.Prune(ts_ms);
+
+    ts_ms_ = ts_ms;
+    view_dirty_ = true;
+    return true;
+}
+
+bool EuroScopeTrafficStore::Upsert(const nlohmann::json& rec, uint64_t ts_ms, bool merge)
+{
+    if (!rec.is_object()) return false;
+    auto cs = rec.find("callsign");
+    if (cs == rec.end() || !cs->is_string() || cs->get_ref<const std::string&>().empty()) return false;
+    const std::string& callsign = cs->get_ref<const std::string&>();
+
+    auto [it, inserted] = aircraft_.try_emplace(callsign);
+    Aircraft& a = it->second;
+
+    bool changed = false;
+    if (inserted) {
+        a.rec = rec;
+        a.lru = by_seen_.insert(by_seen_.end(), callsign);
+        changed = true;
+    }
+    else {
+        by_seen_.splice(by_seen_.end(), by_seen_, a.lru);
+
+        if (merge) {
+            for (auto f = rec.begin(); f != rec.end(); ++f) {
+                if (f.key() == "updated_ms") continue;
+                auto cur = a.rec.find(f.key());
+                if (f->is_null()) {
+                    if (cur != a.rec.end()) {
+                        a.rec.erase(cur);
+                        changed = true;
+                    }
+                }
+                else if (cur == a.rec.end() || *cur != *f) {
+                    a.rec[f.key()] = *f;
+                    changed = true;
+                }
+            }
+        }
+        else {
+            nlohmann::json incoming = rec;
+            incoming["updated_ms"] = a.rec["updated_ms"];
+            if (incoming != a.rec) {
+                a.rec = std::move(incoming);
+                changed = true;
+            }
+        }
+    }
+
+    a.seen_ms = ts_ms;
+    a.gen = gen_;
+    if (changed) {
+        a.rec["updated_ms"] = ts_ms;
+        a.json = Dump(a.rec);
+        aircraft_dirty_ = true;
+        Reindex(a);
+    }
+    return true;
+}
+
+void EuroScopeTrafficStore::Remove(const std::string& callsign)
+{
+    auto it = aircraft_.find(callsign);
+    if (it != aircraft_.end()) Erase(it);
+}
+
+EuroScopeTrafficStore::AircraftMap::iterator EuroScopeTrafficStore::Erase(AircraftMap::iterator it)
+{
+    Unindex(it->second);
+    by_seen_.erase(it->second.lru);
+    aircraft_dirty_ = true;
+    return aircraft_.erase(it);
+}
+
+void EuroScopeTrafficStore::Rewind(uint64_t ts_ms)
+{
+    // Aircraft seen after ts_ms are the tail of by_seen_; restamping them to ts_ms keeps it sorted.
+    for (auto lru = by_seen_.rbegin(); lru != by_seen_.rend(); ++lru) {
+        auto it = aircraft_.find(*lru);
+        if (it == aircraft_.end()) continue;
+        Aircraft& a = it->second;
+        if (a.seen_ms <= ts_ms) break;
+
+        a.seen_ms = ts_ms;
+        if (a.rec.value("updated_ms", (uint64_t)0) > ts_ms) {
+            a.rec["updated_ms"] = ts_ms;
+            a.json = Dump(a.rec);
+            aircraft_dirty_ = true;
+        }
+    }
+    ts_ms_ = ts_ms;
+    view_dirty_ = true;
+}
+
+bool EuroScopeTrafficStore::Expire(uint64_t now_ms)
+{
+    const size_t aircraft = aircraft_.size();
+    const size_t tracks = trails_.size();
+    EvictStale(now_ms);
+    trails_.Prune(now_ms);
+    if (aircraft_.size() == aircraft && trails_.size() == tracks) return false;
+
+    view_dirty_ = true;
+    return true;
+}
+
+void EuroScopeTrafficStore::EvictStale(uint64_t now_ms)
+{
+    if (now_ms < kStaleMs) return;
+    const uint64_t cutoff = now_ms - kStaleMs;
+
+    while (!by_seen_.empty()) {
+        auto it = aircraft_.find(by_seen_.front());
+        if (it == aircraft_.end()) {
+            by_seen_.pop_front();
+            continue;
+        }
+        if (it->second.seen_ms >= cutoff) break;
+        Erase(it);
+    }
+}
+
+void EuroScopeTrafficStore::Reindex(Aircraft& a)
+{
+    double lat = 0.0;
+    double lon = 0.0;
+    if (!ReadPosition(a.rec, lat, lon)) {
+        Unindex(a);
+        return;
+    }
+
+    const uint32_t cell = (uint32_t)(GridRow(lat) * kGridCols + GridCol(lon));
+    a.lat = lat;
+    a.lon = lon;
+    trails_.Record(a.rec["callsign"].get_ref<const std::string&>(), a.rec["updated_ms"].get<uint64_t>(), lat, lon, a.rec);
+    if (a.has_pos && a.cell == cell) return;
+
+    Unindex(a);
+    auto& bucket = grid_[cell];
+    a.has_pos = true;
+    a.cell = cell;
+    a.cell_pos = (uint32_t)bucket.size();
+    bucket.push_back(&a);
+}
+
+void EuroScopeTrafficStore::Unindex(Aircraft& a)
+{
+    if (!a.has_pos) return;
+    a.has_pos = false;
+
+    auto it = grid_.find(a.cell);
+    if (it == grid_.end()) return;
+    auto& bucket = it->second;
+
+    // Swap-remove; the aircraft moved into the hole takes over its position.
+    Aircraft* last = bucket.back();
+    bucket[a.cell_pos] = last;
+    last->cell_pos = a.cell_pos;
+    bucket.pop_back();
+    if (bucket.empty()) grid_.erase(it);
+}
+
+const std::string& EuroScopeTrafficStore::ViewJson() const
+{
+    if (!view_dirty_) return view_json_;
+
+    if (summary_dirty_) {
+        summary_json_ = Dump(summary_);
+        summary_dirty_ = false;
+    }
+
+    if (aircraft_dirty_) {
+        size_t bytes = 0;
+        for (const auto& kv : aircraft_) bytes += kv.second.json.size() + 1;
+
+        aircraft_json_.clear();
+        aircraft_json_.reserve(bytes);
+        for (const auto& kv : aircraft_) {
+            if (!aircraft_json_.empty()) aircraft_json_ += ',';
+            aircraft_json_ += kv.second.json;
+        }
+        aircraft_dirty_ = false;
+    }
+
+    // summary_json_ is "{...}": reopen it and append the store's own fields.
+    view_json_.clear();
+    view_json_.reserve(summary_json_.size() + aircraft_json_.size() + 96);
+    view_json_.append(summary_json_, 0, summary_json_.size() - 1);
+    if (summary_json_.size() > 2) view_json_ += ',';
+    view_json_ += "\"ts_ms\":" + std::to_string(ts_ms_);
+    view_json_ += ",\"aircraft_count\":" + std::to_string(aircraft_.size());
+    view_json_ += ",\"aircraft\":[";
+    view_json_ += aircraft_json_;
+    view_json_ += "]}";
+
+    view_dirty_ = false;
+    return view_json_;
+}
+
+nlohmann::json EuroScopeTrafficStore::SummaryJson() const
+{
+    nlohmann::json out = summary_;
+    out["ts_ms"] = ts_ms_;
+    out["aircraft_count"] = aircraft_.size();
+    return out;
+}
+
+bool EuroScopeTrafficStore::FieldPosition(double& lat, double& lon) const
+{
+    nlohmann::json pos = {
+        { "lat", summary_.value("airport_lat", nlohmann::json()) },
+        { "lon", summary_.value("airport_lon", nlohmann::json()) }
+    };
+    return ReadPosition(pos, lat, lon);
+}
+
+nlohmann::json EuroScopeTrafficStore::NearbyJson(double lat, double lon, double radius_nm, int limit) const
+{
+    limit = std::max(1, std::min(limit, kMaxNearby));
+    radius_nm = std::max(0.1, std::min(radius_nm, 3000.0));
+
+    struct Hit {
+        double distance_nm;
+        const Aircraft* a;
+    };
+    std::vector<Hit> hits;
+
+    auto consider = [&](const Aircraft* a) {
+        const double d = DistanceNm(lat, lon, a->lat, a->lon);
+        if (d <= radius_nm) hits.push_back(Hit{ d, a });
+    };
+
+    // Bounding box in cells. A degree of latitude is 60 nm; longitude shrinks with cos(lat),
+    // taken at the box edge nearest a pole.
+    const double dlat = radius_nm / 60.0;
+    const int row0 = GridRow(lat - dlat);
+    const int row1 = GridRow(lat + dlat);
+    const double edge_lat = std::min(89.0, std::max(std::fabs(lat - dlat), std::fabs(lat + dlat)));
+    const double dlon = (lat + dlat >= 89.0 || lat - dlat <= -89.0) ? 360.0 : dlat / std::cos(Rad(edge_lat));
+    const int cols = dlon >= 180.0 ? kGridCols : std::min(kGridCols, 2 * (int)std::ceil(dlon / kCellDeg) + 1);
+    const int col0 = dlon >= 180.0 ? 0 : GridCol(lon - dlon);
+
+    const std::size_t cells = (std::size_t)(row1 - row0 + 1) * (std::size_t)cols;
+    if (cells > grid_.size()) {
+        // Large radius or sparse sector: walking the occupied cells is cheaper.
+        for (const auto& kv : grid_) {
+            const int row = (int)(kv.first / kGridCols);
+            if (row < row0 || row > row1) continue;
+            for (const Aircraft* a : kv.second) consider(a);
+        }
+    }
+    else {
+        for (int row = row0; row <= row1; ++row) {
+            for (int i = 0; i < cols; ++i) {
+                const uint32_t cell = (uint32_t)(row * kGridCols + (col0 + i) % kGridCols);
+                auto it = grid_.find(cell);
+                if (it == grid_.end()) continue;
+                for (const Aircraft* a : it->second) consider(a);
+            }
+        }
+    }
+
+    const std::size_t n = std::min(hits.size(), (std::size_t)limit);
+    std::partial_sort(hits.begin(), hits.begin() + n, hits.end(), [](const Hit& x, const Hit& y) {
+        if (x.distance_nm != y.distance_nm) return x.distance_nm < y.distance_nm;
+        return x.a->rec["callsign"].get_ref<const std::string&>() < y.a->rec["callsign"].get_ref<const std::string&>();
+    });
+
+    nlohmann::json out;
+    out["lat"] = lat;
+    out["lon"] = lon;
+    out["radius_nm"] = radius_nm;
+    out["ts_ms"] = ts_ms_;
+    out["count"] = hits.size();
+    out["aircraft"] = nlohmann::json::array();
+    for (std::size_t i = 0; i < n; ++i) {
+        nlohmann::json item = hits[i].a->rec;
+        item["distance_nm"] = Round2(hits[i].distance_nm);
+        item["bearing_deg"] = Round2(BearingDeg(lat, lon, hits[i].a->lat, hits[i].a->lon));
+        out["aircraft"].push_back(std::move(item));
+    }
+    return out;
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <cstdint>
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "json.hpp"
+#include "EuroScopeTrailStore.h"
+
+// EuroScope traffic keyed by callsign, plus the sector summary the plugin sends alongside it
+// (airport, runways, inbound/depa lists, next_arrival, ...).
+//
+// A message is either a full snapshot or a delta ("delta": true):
+//   { "ts_ms": <u64>, <summary fields...>, "aircraft": [ { "callsign": "BAW123", ... }, ... ] }
+//   { "ts_ms": <u64>, "delta": true, <changed summary fields...>,
+//     "aircraft": [ <changed aircraft; fields merged, null removes a field> ], "removed": [ "BAW123" ] }
+// A snapshot replaces the summary and the aircraft set; a delta only touches what it names.
+//
+// Each aircraft keeps its own serialized fragment, re-dumped only when that aircraft changes,
+// and aircraft no message has named for kStaleMs are evicted oldest first. A message older than
+// the previous one means the plugin clock was reset; existing aircraft are restamped to it so
+// they still age out. The served view is assembled from the cached pieces and rebuilt only
+// after a change, so ingest and read costs follow the number of changed aircraft rather than
+// the size of the sector.
+//
+// Aircraft with numeric "lat"/"lon" are also kept in a grid of kCellDeg cells, so a radius
+// query only visits the cells its bounding box covers, and their positions feed the trail
+// history (EuroScopeTrailStore), which outlives the aircraft entry.
+//
+// Not thread-safe; EuroScopeIngestService guards it with its mutex.
+class EuroScopeTrafficStore
+{
+public:
+    static constexpr uint64_t kStaleMs = 30000;
+    static constexpr double kCellDeg = 0.25;
+    static constexpr int kMaxNearby = 1000;
+
+    // Applies one message. `ts_ms` is the message time (already validated by the caller).
+    bool Apply(nlohmann::json msg, uint64_t ts_ms, std::string& err);
+
+    // Evicts stale aircraft and trails as of `now_ms` (plugin clock) without a message, for
+    // when the plugin has gone quiet. True when anything was dropped.
+    bool Expire(uint64_t now_ms);
+
+    // { <summary...>, "ts_ms", "aircraft_count", "aircraft": [ ... sorted by callsign ] }
+    const std::string& ViewJson() const;
+
+    // Summary fields plus ts_ms and aircraft_count (no aircraft list), for /api/metrics.
+    nlohmann::json SummaryJson() const;
+
+    // Aircraft within `radius_nm` of (lat, lon), nearest first, each with distance_nm and
+    // bearing_deg added: { "lat", "lon", "radius_nm", "ts_ms", "count", "aircraft": [...] }.
+    nlohmann::json NearbyJson(double lat, double lon, double radius_nm, int limit) const;
+
+    // Reference point for queries that do not name one: the summary's airport_lat/airport_lon.
+    bool FieldPosition(double& lat, double& lon) const;
+
+    const EuroScopeTrailStore& trails() const { return trails_; }
+
+    uint64_t ts_ms() const { return ts_ms_; }
+    size_t size() const { return aircraft_.size(); }
+
+private:
+    struct Aircraft {
+        nlohmann::json rec;          // includes "callsign" and "updated_ms" (last change)
+        std::string json;            // rec.dump(), redone only when rec changes
+        uint64_t seen_ms = 0;        // last message that named this aircraft (staleness)
+        uint64_t gen = 0;            // Apply() that last named it (snapshot sweep)
+        std::list<std::string>::iterator lru; // position in by_seen_
+
+        bool has_pos = false;        // listed in grid_[cell] at cell_pos
+        double lat = 0.0;
+        double lon = 0.0;
+        uint32_t cell = 0;
+        uint32_t cell_pos = 0;
+    };
+    using AircraftMap = std::map<std::string, Aircraft>;
+
+    // Inserts or updates one record; returns false when it has no usable callsign.
+    bool Upsert(const nlohmann::json& rec, uint64_t ts_ms, bool merge);
+    void Remove(const std::string& callsign);
+    AircraftMap::iterator Erase(AircraftMap::iterator it);
+    void EvictStale(uint64_t now_ms);
+    // Plugin clock reset: restamps aircraft seen after ts_ms to ts_ms so they age out on the
+    // new clock, and moves ts_ms_ back.
+    void Rewind(uint64_t ts_ms);
+
+    // Moves `a` to the grid cell of its current lat/lon (or out of the grid without one).
+    void Reindex(Aircraft& a);
+    void Unindex(Aircraft& a);
+
+    nlohmann::json summary_ = nlohmann::json::object();
+    uint64_t ts_ms_ = 0;
+
+    AircraftMap aircraft_;
+    std::list<std::string> by_seen_; // least recently seen first
+    uint64_t gen_ = 0;
+
+    // Cell id (row * columns + column) -> aircraft in it; map nodes never move, so the
+    // pointers stay valid until Erase().
+    std::unordered_map<uint32_t, std::vector<Aircraft*>> grid_;
+
+    EuroScopeTrailStore trails_;
+
+    mutable bool summary_dirty_ = true;
+    mutable bool aircraft_dirty_ = true;
+    mutable bool view_dirty_ = true;
+    mutable std::string summary_json_;
+    mutable std::string aircraft_json_;
+    mutable std::string view_json_;
+};
@@ -0,0 +1,215 @@
+#include "EuroScopeTrailStore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+double NumberOr(const nlohmann::json& rec, const char* key, const char* alt_key, double fallback)
+{
+    auto it = rec.find(key);
+    if (it == rec.end() || !it->is_number()) it = rec.find(alt_key);
+    if (it == rec.end() || !it->is_number()) return fallback;
+    const double v = it->get<double>();
+    return std::isfinite(v) ? v : fallback;
+}
+
+// Trail coordinates are stored as float; print them at ~1 m instead of float noise.
+double Coord(float v)
+{
+    return std::round((double)v * 1e5) / 1e5;
+}
+
+template <typename T>
+void Put(std::string& out, T v)
+{
+    // Little-endian on every platform we build for (x86/x64).
+    char b[sizeof(T)];
+    std::memcpy(b, &v, sizeof(T));
+    out.append(b, sizeof(T));
+}
+
+} // namespace
+
+uint32_t EuroScopeTrailStore::Track::Skip(uint64_t since_ms) const
+{
+    // Samples are in time order (Record() only appends newer ones).
+    uint32_t lo = 0;
+    uint32_t hi = count;
+    while (lo < hi) {
+        const uint32_t mid = (lo + hi) / 2;
+        if (ts_ms[At(mid)] <= since_ms) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+void EuroScopeTrailStore::Record(const std::string& callsign, uint64_t ts_ms, double lat, double lon,
+    const nlohmann::json& rec)
+{
+    // The plugin clock went backwards (EuroScope restart): older history cannot be ordered
+    // against the new clock.
+    if (ts_ms < ts_ms_) Rewind(ts_ms);
+
+    auto found = index_.find(callsign);
+    if (found != index_.end()) {
+        const Track& t = slots_[found->second];
+        if (t.count > 0 && ts_ms < t.last_ms + kIntervalMs) return;
+    }
+
+    const uint32_t slot = found != index_.end() ? found->second : Acquire(callsign);
+    Track& t = slots_[slot];
+
+    const double alt = NumberOr(rec, "alt_ft", "altitude_ft", std::nan(""));
+    const double gs = NumberOr(rec, "gs_kt", "gs", std::nan(""));
+
+    t.ts_ms[t.head] = ts_ms;
+    t.lat[t.head] = (float)lat;
+    t.lon[t.head] = (float)lon;
+    t.alt_ft[t.head] = std::isnan(alt) ? kNoAlt : (int32_t)std::lround(std::max(-2000.0, std::min(alt, 100000.0)));
+    t.gs_kt[t.head] = std::isnan(gs) ? kNoGs : (int16_t)std::lround(std::max(0.0, std::min(gs, 5000.0)));
+    t.head = (uint32_t)((t.head + 1) % kPoints);
+    if (t.count < kPoints) ++t.count;
+    t.last_ms = ts_ms;
+
+    if (ts_ms > ts_ms_) ts_ms_ = ts_ms;
+}
+
+uint32_t EuroScopeTrailStore::Acquire(const std::string& callsign)
+{
+    uint32_t slot = 0;
+    if (!free_.empty()) {
+        slot = free_.back();
+        free_.pop_back();
+    }
+    else if (slots_.size() < kMaxTracks) {
+        slot = (uint32_t)slots_.size();
+        slots_.emplace_back();
+    }
+    else {
+        // Full: reuse the track that was updated longest ago. Only reached when more than
+        // kMaxTracks callsigns were seen inside kTrackTtlMs.
+        for (uint32_t i = 1; i < slots_.size(); ++i) {
+            if (slots_[i].last_ms < slots_[slot].last_ms) slot = i;
+        }
+        index_.erase(slots_[slot].callsign);
+    }
+
+    Track& t = slots_[slot];
+    t.callsign = callsign;
+    t.head = 0;
+    t.count = 0;
+    t.last_ms = 0;
+    index_[callsign] = slot;
+    return slot;
+}
+
+template <typename Pred>
+void EuroScopeTrailStore::DropIf(Pred pred)
+{
+    for (auto it = index_.begin(); it != index_.end();) {
+        Track& t = slots_[it->second];
+        if (pred(t)) {
+            t.callsign.clear();
+            t.count = 0;
+            free_.push_back(it->second);
+            it = index_.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void EuroScopeTrailStore::Prune(uint64_t now_ms)
+{
+    if (now_ms < kTrackTtlMs) return;
+    const uint64_t cutoff = now_ms - kTrackTtlMs;
+    DropIf([cutoff](const Track& t) { return t.last_ms < cutoff; });
+}
+
+void EuroScopeTrailStore::Rewind(uint64_t ts_ms)
+{
+    // Tracks stamped by the old clock would otherwise look newer than anything Prune() or
+    // Acquire() compares them with, and never be released.
+    DropIf([ts_ms](const Track& t) { return t.last_ms > ts_ms; });
+    ts_ms_ = ts_ms;
+}
+
+nlohmann::json EuroScopeTrailStore::Json(uint64_t since_ms) const
+{
+    nlohmann::json trails = nlohmann::json::array();
+    for (const auto& kv : index_) {
+        const Track& t = slots_[kv.second];
+        const uint32_t first = t.Skip(since_ms);
+        if (first >= t.count) continue;
+
+        nlohmann::json ts = nlohmann::json::array();
+        nlohmann::json lat = nlohmann::json::array();
+        nlohmann::json lon = nlohmann::json::array();
+        nlohmann::json alt = nlohmann::json::array();
+        nlohmann::json gs = nlohmann::json::array();
+        for (uint32_t i = first; i < t.count; ++i) {
+            const uint32_t k = t.At(i);
+            ts.push_back(t.ts_ms[k]);
+            lat.push_back(Coord(t.lat[k]));
+            lon.push_back(Coord(t.lon[k]));
+            if (t.alt_ft[k] == kNoAlt) alt.push_back(nullptr);
+            else alt.push_back(t.alt_ft[k]);
+            if (t.gs_kt[k] == kNoGs) gs.push_back(nullptr);
+            else gs.push_back(t.gs_kt[k]);
+        }
+
+        trails.push_back({
+            { "callsign", t.callsign },
+            { "ts_ms", std::move(ts) },
+            { "lat", std::move(lat) },
+            { "lon", std::move(lon) },
+            { "alt_ft", std::move(alt) },
+            { "gs_kt", std::move(gs) }
+        });
+    }
+
+    nlohmann::json out;
+    out["ts_ms"] = ts_ms_;
+    out["interval_ms"] = kIntervalMs;
+    out["points_max"] = kPoints;
+    out["trails"] = std::move(trails);
+    return out;
+}
+
+std::string EuroScopeTrailStore::Binary(uint64_t since_ms) const
+{
+    std::string out;
+    out.append("ESTR", 4);
+    Put<uint16_t>(out, 1);
+    const size_t count_at = out.size();
+    Put<uint16_t>(out, 0);
+    Put<uint64_t>(out, ts_ms_);
+
+    uint16_t tracks = 0;
+    for (const auto& kv : index_) {
+        const Track& t = slots_[kv.second];
+        const uint32_t first = t.Skip(since_ms);
+        if (first >= t.count) continue;
+
+        const size_t cs_len = std::min<size_t>(t.callsign.size(), 255);
+        Put<uint8_t>(out, (uint8_t)cs_len);
+        out.append(t.callsign.data(), cs_len);
+
+        const uint16_t n = (uint16_t)(t.count - first);
+        const uint64_t t0 = t.ts_ms[t.At(first)];
+        Put<uint16_t>(out, n);
+        Put<uint64_t>(out, t0);
+        for (uint32_t i = first; i < t.count; ++i) Put<uint32_t>(out, (uint32_t)(t.ts_ms[t.At(i)] - t0));
+        for (uint32_t i = first; i < t.count; ++i) Put<float>(out, t.lat[t.At(i)]);
+        for (uint32_t i = first; i < t.count; ++i) Put<float>(out, t.lon[t.At(i)]);
+        for (uint32_t i = first; i < t.count; ++i) Put<int32_t>(out, t.alt_ft[t.At(i)]);
+        for (uint32_t i = first; i < t.count; ++i) Put<int16_t>(out, t.gs_kt[t.At(i)]);
+        ++tracks;
+    }
+
+    std::memcpy(&out[count_at], &tracks, sizeof(tracks));
+    return out;
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "json.hpp"
+
+// Position history per callsign for radar-style trails and short replays.
+//
+// Each track is a ring of kPoints samples stored column by column (ts/lat/lon/alt/gs), and a
+// new sample is kept only when kIntervalMs has passed since the previous one, so a track
+// covers kPoints * kIntervalMs of history whatever the update rate. At most kMaxTracks tracks
+// exist (the one updated longest ago makes room for a new callsign) and a track with no
+// sample for kTrackTtlMs is dropped, so memory is fixed at about
+// kMaxTracks * kPoints * 22 bytes regardless of session length.
+//
+// Not thread-safe; owned by EuroScopeTrafficStore.
+class EuroScopeTrailStore
+{
+public:
+    static constexpr size_t kPoints = 120;
+    static constexpr uint64_t kIntervalMs = 4000;
+    static constexpr size_t kMaxTracks = 1000;
+    static constexpr uint64_t kTrackTtlMs = 10 * 60 * 1000;
+
+    static constexpr int32_t kNoAlt = std::numeric_limits<int32_t>::min();
+    static constexpr int16_t kNoGs = -1;
+
+    // Adds a sample unless the track already has one from the last kIntervalMs.
+    // Altitude comes from "alt_ft" (or "altitude_ft") and ground speed from "gs_kt" (or "gs").
+    // A ts_ms older than the newest sample means the plugin clock was reset: every track from
+    // the old clock is dropped and ts_ms restarts from the new value.
+    void Record(const std::string& callsign, uint64_t ts_ms, double lat, double lon, const nlohmann::json& rec);
+
+    // Drops tracks whose newest sample is older than kTrackTtlMs.
+    void Prune(uint64_t now_ms);
+
+    // Samples newer than since_ms, oldest first:
+    // { "ts_ms": <newest sample>, "interval_ms", "points_max",
+    //   "trails": [ { "callsign", "ts_ms": [...], "lat": [...], "lon": [...], "alt_ft": [...], "gs_kt": [...] } ] }
+    // alt_ft/gs_kt entries are null where the plugin did not send them. A top-level ts_ms below
+    // the caller's since_ms means the history was reset; poll again from since_ms=0.
+    nlohmann::json Json(uint64_t since_ms) const;
+
+    // Same selection as Json(), little-endian binary:
+    //   "ESTR" u16 version(1) u16 track_count u64 ts_ms
+    //   per track: u8 callsign_len, callsign, u16 n, u64 t0,
+    //              n x u32 (ts_ms - t0), n x f32 lat, n x f32 lon, n x i32 alt_ft (kNoAlt), n x i16 gs_kt (kNoGs)
+    std::string Binary(uint64_t since_ms) const;
+
+    size_t size() const { return index_.size(); }
+
+private:
+    struct Track {
+        std::string callsign;
+        uint32_t head = 0;  // slot the next sample goes into
+        uint32_t count = 0;
+        uint64_t last_ms = 0;
+
+        std::array<uint64_t, kPoints> ts_ms;
+        std::array<float, kPoints> lat;
+        std::array<float, kPoints> lon;
+        std::array<int32_t, kPoints> alt_ft;
+        std::array<int16_t, kPoints> gs_kt;
+
+        // Ring index of the i-th sample, oldest first.
+        uint32_t At(uint32_t i) const { return (uint32_t)((head + kPoints - count + i) % kPoints); }
+        // Number of leading (oldest) samples at or before since_ms.
+        uint32_t Skip(uint64_t since_ms) const;
+    };
+
+    uint32_t Acquire(const std::string& callsign);
+    // Drops every track newer than ts_ms and moves the store clock back to it.
+    void Rewind(uint64_t ts_ms);
+    // Releases the tracks matching `pred` to free_.
+    template <typename Pred>
+    void DropIf(Pred pred);
+
+    std::vector<Track> slots_;       // grows to kMaxTracks, never shrinks
+    std::vector<uint32_t> free_;     // slots released by Prune()
+    std::unordered_map<std::string, uint32_t> index_;
+    uint64_t ts_ms_ = 0;             // newest sample overall
+};
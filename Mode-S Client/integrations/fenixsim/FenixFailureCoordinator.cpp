@@ -59,6 +59,8 @@ void FenixFailureCoordinator::Start(AppState& state, FenixSimFailuresClient& cli
         log_ = std::move(log);
         seen_keys_.clear();
         seen_order_.clear();
+        inbox_.clear();
+        inbox_dropped_ = 0;
         pending_credits_ = 0;
         twitch_bits_remainder_ = 0;
         tiktok_gift_remainder_ = 0;
@@ -76,20 +78,50 @@ void FenixFailureCoordinator::Start(AppState& state, FenixSimFailuresClient& cli
     RefreshFailureMetadataOnStart();
 
     running_.store(true);
+
+    // Only events published from now on earn credits; the worker picks them up as they arrive.
+    const std::uint64_t sub_id = state.subscribe_support_events("fenix-failures",
+        [this](const SupportEvent& ev) { OnSupportEvent(ev); });
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        support_sub_id_ = sub_id;
+    }
+
     worker_ = std::thread(&FenixFailureCoordinator::WorkerLoop, this);
 }
 
 void FenixFailureCoordinator::Stop() {
-    running_.store(false);
+    AppState* state = nullptr;
+    std::uint64_t sub_id = 0;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        state = state_;
+        sub_id = support_sub_id_;
+        support_sub_id_ = 0;
+    }
+    if (state != nullptr && sub_id != 0) {
+        state->unsubscribe_support_events(sub_id);
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        running_.store(false);
+    }
+    cv_.notify_all();
     if (worker_.joinable()) {
         worker_.join();
     }
 }
 
 void FenixFailureCoordinator::SetEnabled(bool enabled) {
-    std::lock_guard<std::mutex> lk(mu_);
-    automation_enabled_ = enabled;
-    last_no_trigger_log_ms_ = 0;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        automation_enabled_ = enabled;
+        last_no_trigger_log_ms_ = 0;
+        wake_ = enabled;
+    }
+    // Spend credits queued while disabled right away.
+    cv_.notify_all();
 }
 
 bool FenixFailureCoordinator::enabled() const {
@@ -199,16 +231,19 @@ nlohmann::json FenixFailureCoordinator::StatusJson() const {
     FenixSimFailuresClient* client = nullptr;
     bool enabled_now = false;
     int pending_now = 0;
+    std::uint64_t dropped_now = 0;
 
     {
         std::lock_guard<std::mutex> lk(mu_);
         client = client_;
         enabled_now = automation_enabled_;
         pending_now = pending_credits_;
+        dropped_now = inbox_dropped_;
     }
 
     out["enabled"] = enabled_now;
     out["pending_credits"] = pending_now;
+    out["events_dropped"] = dropped_now;
     out["selection_mode"] = "60% immediate / 40% armed";
     out["mode_label"] = "60% immediate / 40% armed";
 
@@ -323,13 +358,25 @@ void FenixFailureCoordinator::RefreshFailureMetadataOnStart() {
 }
 
 void FenixFailureCoordinator::WorkerLoop() {
-    SeedSeenFromCurrentQueues();
     Log(L"FENIX: failure coordinator started.");
 
     while (running_.load()) {
+        // Wakes as soon as an event is queued; the timeout retries credits left pending by a
+        // failed or skipped trigger.
+        std::deque<SupportEvent> batch;
+        {
+            std::unique_lock<std::mutex> lk(mu_);
+            cv_.wait_for(lk, std::chrono::milliseconds(500), [this]() {
+                return !running_.load() || !inbox_.empty() || wake_;
+            });
+            wake_ = false;
+            batch.swap(inbox_);
+        }
+        if (!running_.load()) break;
+
         try {
             std::vector<nlohmann::json> new_events;
-            CollectNewEvents(new_events);
+            CollectNewEvents(batch, new_events);
 
             for (const auto& event : new_events) {
                 const int credits = CreditsFromEvent(event);
@@ -381,70 +428,33 @@ void FenixFailureCoordinator::WorkerLoop() {
         catch (...) {
             Log(L"FENIX: failure coordinator exception: unknown");
         }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(500));
     }
 
     Log(L"FENIX: failure coordinator stopped.");
 }
 
-void FenixFailureCoordinator::SeedSeenFromCurrentQueues() {
-    AppState* state = nullptr;
-    {
-        std::lock_guard<std::mutex> lk(mu_);
-        state = state_;
-    }
-    if (state == nullptr) return;
-
-    std::vector<nlohmann::json> seed_events;
-    CollectNewEvents(seed_events);
-    (void)seed_events;
-}
-
-void FenixFailureCoordinator::CollectNewEvents(std::vector<nlohmann::json>& out_events) {
-    out_events.clear();
-
-    AppState* state = nullptr;
+void FenixFailureCoordinator::OnSupportEvent(const SupportEvent& ev) {
     {
         std::lock_guard<std::mutex> lk(mu_);
-        state = state_;
-    }
-    if (state == nullptr) return;
-
-    try {
-        const auto twitch = state->twitch_eventsub_events_json(200);
-        if (twitch.is_object() && twitch.contains("events") && twitch["events"].is_array()) {
-            CollectNewEventsFromArray("twitch", twitch["events"], out_events);
+        if (!running_.load()) return;
+        if (inbox_.size() >= kInboxMax_) {
+            inbox_.pop_front();
+            ++inbox_dropped_;
         }
+        inbox_.push_back(ev);
     }
-    catch (...) {}
-
-    try {
-        const auto tiktok = state->tiktok_events_json(200);
-        if (tiktok.is_object() && tiktok.contains("events") && tiktok["events"].is_array()) {
-            CollectNewEventsFromArray("tiktok", tiktok["events"], out_events);
-        }
-    }
-    catch (...) {}
-
-    try {
-        const auto youtube = state->youtube_events_json(200);
-        if (youtube.is_object() && youtube.contains("events") && youtube["events"].is_array()) {
-            CollectNewEventsFromArray("youtube", youtube["events"], out_events);
-        }
-    }
-    catch (...) {}
+    cv_.notify_one();
 }
 
-void FenixFailureCoordinator::CollectNewEventsFromArray(const char* platform,
-                                                        const nlohmann::json& events,
-                                                        std::vector<nlohmann::json>& out_events) {
-    if (!events.is_array()) return;
+void FenixFailureCoordinator::CollectNewEvents(std::deque<SupportEvent>& batch,
+                                               std::vector<nlohmann::json>& out_events) {
+    out_events.clear();
 
-    for (const auto& event : events) {
-        if (!event.is_object()) continue;
+    for (const auto& ev : batch) {
+        if (!ev.payload || !ev.payload->is_object()) continue;
 
-        nlohmann::json normalized = event;
+        const char* platform = SupportPlatformName(ev.platform);
+        nlohmann::json normalized = *ev.payload;
         if (!normalized.contains("platform")) {
             normalized["platform"] = platform;
         }
@@ -456,6 +466,7 @@ void FenixFailureCoordinator::CollectNewEventsFromArray(const char* platform,
             out_events.push_back(std::move(normalized));
         }
     }
+    batch.clear();
 }
 
 std::string FenixFailureCoordinator::MakeEventKey(const char* platform, const nlohmann::json& event) const {
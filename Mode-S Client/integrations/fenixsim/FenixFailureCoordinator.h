@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <deque>
 #include <functional>
@@ -14,6 +15,7 @@
 #include <vector>
 
 #include "json.hpp"
+#include "core/SupportEventBus.h"
 #include "fenixsim/FenixFailureMetadataStore.h"
 
 class AppState;
@@ -45,11 +47,9 @@ private:
     void WorkerLoop();
     void RefreshFailureMetadataOnStart();
 
-    void SeedSeenFromCurrentQueues();
-    void CollectNewEvents(std::vector<nlohmann::json>& out_events);
-    void CollectNewEventsFromArray(const char* platform,
-                                   const nlohmann::json& events,
-                                   std::vector<nlohmann::json>& out_events);
+    // Bus handler (runs on the producing platform thread): queues the event and wakes the worker.
+    void OnSupportEvent(const SupportEvent& ev);
+    void CollectNewEvents(std::deque<SupportEvent>& batch, std::vector<nlohmann::json>& out_events);
 
     std::string MakeEventKey(const char* platform, const nlohmann::json& event) const;
     bool RememberEventKey(const std::string& key);
@@ -96,6 +96,14 @@ private:
     std::atomic<bool> running_{ false };
 
     mutable std::mutex mu_;
+    std::condition_variable cv_; // inbox_ non-empty, automation enabled, or stopping
+    bool wake_ = false;          // set by SetEnabled(true) so queued credits are spent without waiting
+    std::uint64_t support_sub_id_ = 0;
+    std::deque<SupportEvent> inbox_;
+    std::uint64_t inbox_dropped_ = 0;
+    static constexpr std::size_t kInboxMax_ = 4096;
+
+    // Still deduped: the bus delivers each event once, but EventSub may redeliver a notification.
     std::unordered_set<std::string> seen_keys_;
     std::deque<std::string> seen_order_;
     static constexpr std::size_t kSeenMax_ = 4096;
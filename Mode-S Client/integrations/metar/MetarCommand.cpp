@@ -109,6 +109,20 @@ bool TryFetchMetarFromAviationWeather(const std::string& icaoUpper,
 
 } // namespace
 
+bool IsMetarCommand(const std::string& messageText)
+{
+    const std::string trimmed = TrimAscii(messageText);
+    if (trimmed.size() < 6 || trimmed[0] != '!') {
+        return false;
+    }
+
+    const size_t firstSpace = trimmed.find_first_of(" \t\r\n");
+    std::string cmd = trimmed.substr(1, firstSpace == std::string::npos ? std::string::npos : firstSpace - 1);
+    std::transform(cmd.begin(), cmd.end(), cmd.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return cmd == "metar";
+}
+
 bool TryGetMetarReply(const std::string& messageText,
     std::string& outReply,
     std::string* outLogError)
@@ -4,6 +4,9 @@
 
 namespace metar {
 
+// Cheap check (no network): true when the message is a !metar command.
+bool IsMetarCommand(const std::string& messageText);
+
 // Returns true when the message was recognised as a !metar command, even if lookup fails.
 // On success, outReply contains the text to send back to chat.
 // On lookup errors, outLogError receives a diagnostic string suitable for logging.
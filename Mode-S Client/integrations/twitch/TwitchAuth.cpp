@@ -14,6 +14,7 @@
 #endif
 
 #include "TwitchAuth.h"
+#include "core/ConfigWriteBehind.h"
 #include "core/StringUtil.h"
 #include "log/UiLog.h"
 #include "../../src/oauth/EmbeddedOAuthConfig.h"
@@ -278,41 +279,6 @@ namespace {
             return false;
         }
     }
-
-    bool WriteJsonFileAtomic(const std::filesystem::path& p, const json& j, std::string* out_error) {
-        std::error_code ec;
-        if (!p.parent_path().empty()) std::filesystem::create_directories(p.parent_path(), ec);
-
-        auto tmp = p;
-        tmp += ".tmp";
-
-        {
-            std::ofstream f(tmp, std::ios::out | std::ios::binary | std::ios::trunc);
-            if (!f) {
-                if (out_error) *out_error = "Failed to open temp config for write: " + tmp.string();
-                return false;
-            }
-            f << j.dump(2);
-            f.flush();
-            if (!f) {
-                if (out_error) *out_error = "Failed while writing temp config: " + tmp.string();
-                return false;
-            }
-        }
-
-        std::filesystem::rename(tmp, p, ec);
-        if (ec) {
-            // Windows rename over existing can fail; fallback: remove then rename
-            std::filesystem::remove(p, ec);
-            ec.clear();
-            std::filesystem::rename(tmp, p, ec);
-        }
-        if (ec) {
-            if (out_error) *out_error = "Failed to replace config atomically: " + ec.message();
-            return false;
-        }
-        return true;
-    }
 } // namespace
 
 std::int64_t TwitchAuth::NowUnixSeconds() {
@@ -662,23 +628,14 @@ bool TwitchAuth::SaveToConfig(const TokenSnapshot& snap, std::string* out_error)
     auto path = FindConfigPath();
     DebugLog(std::string("saving tokens to config path: ") + path.string());
 
-    json j = json::object();
-    std::string read_err;
-    if (!ReadJsonFile(path, &j, &read_err)) {
-        j = json::object();
-    }
-
-    j.erase("twitch_client_id");
-    j.erase("twitch_client_secret");
-
-    if (!j.contains("twitch") || !j["twitch"].is_object()) {
-        j["twitch"] = json::object();
-    }
-
-    j["twitch"]["user_access_token"] = snap.access_token;
-    j["twitch"]["user_refresh_token"] = snap.refresh_token;
-
-    return WriteJsonFileAtomic(path, j, out_error);
+    // Applied on top of the shared config document; the flush waits for the write so a
+    // rotated refresh token is on disk before we report success.
+    auto& writer = SharedConfigWriter();
+    writer.Erase(path, "/twitch_client_id");
+    writer.Erase(path, "/twitch_client_secret");
+    writer.Set(path, "/twitch/user_access_token", snap.access_token);
+    writer.Set(path, "/twitch/user_refresh_token", snap.refresh_token);
+    return writer.Flush(out_error);
 }
 
 bool TwitchAuth::NeedsRefresh(std::int64_t now_unix) const {
@@ -0,0 +1,139 @@
+#include "twitch/TwitchChannelPointsStore.h"
+
+#include <algorithm>
+
+namespace twitch {
+
+namespace {
+
+const char* QueueStateName(RedemptionQueue q) {
+    switch (q) {
+    case RedemptionQueue::Pending: return "pending";
+    case RedemptionQueue::Live: return "live";
+    case RedemptionQueue::History: return "history";
+    }
+    return "";
+}
+
+} // namespace
+
+TwitchChannelPointsStore::TwitchChannelPointsStore(std::size_t max_per_queue)
+    : max_per_queue_(std::max<std::size_t>(1, max_per_queue)) {
+    slots_.reserve(max_per_queue_ * kQueues);
+}
+
+std::uint32_t TwitchChannelPointsStore::Alloc() {
+    if (!free_.empty()) {
+        const std::uint32_t i = free_.back();
+        free_.pop_back();
+        return i;
+    }
+    slots_.emplace_back();
+    return static_cast<std::uint32_t>(slots_.size() - 1);
+}
+
+void TwitchChannelPointsStore::Unlink(Queue& queue, std::uint32_t i) {
+    Slot& s = slots_[i];
+    if (s.prev != kNil) slots_[s.prev].next = s.next;
+    else queue.head = s.next;
+    if (s.next != kNil) slots_[s.next].prev = s.prev;
+    else queue.tail = s.prev;
+    s.prev = s.next = kNil;
+    --queue.size;
+}
+
+void TwitchChannelPointsStore::Release(Queue& queue, std::uint32_t i) {
+    Slot& s = slots_[i];
+    if (s.rec && !s.rec->redemption_id.empty()) {
+        auto it = queue.index.find(s.rec->redemption_id);
+        if (it != queue.index.end() && it->second == i) queue.index.erase(it);
+    }
+    Unlink(queue, i);
+    s.rec.reset();
+    s.history_ts_ms = 0;
+    free_.push_back(i);
+}
+
+void TwitchChannelPointsStore::Upsert(RedemptionQueue q, RecordPtr rec, std::int64_t history_ts_ms) {
+    if (!rec) return;
+    Queue& queue = queues_[static_cast<std::size_t>(q)];
+
+    if (!rec->redemption_id.empty()) {
+        auto it = queue.index.find(rec->redemption_id);
+        if (it != queue.index.end()) Release(queue, it->second);
+    }
+
+    const std::uint32_t i = Alloc();
+    Slot& s = slots_[i];
+    s.rec = std::move(rec);
+    s.history_ts_ms = history_ts_ms;
+    s.prev = queue.tail;
+    s.next = kNil;
+    if (queue.tail != kNil) slots_[queue.tail].next = i;
+    else queue.head = i;
+    queue.tail = i;
+    ++queue.size;
+
+    if (!s.rec->redemption_id.empty()) queue.index[s.rec->redemption_id] = i;
+
+    while (queue.size > max_per_queue_) Release(queue, queue.head);
+}
+
+TwitchChannelPointsStore::RecordPtr TwitchChannelPointsStore::Take(RedemptionQueue q, const std::string& redemption_id) {
+    if (redemption_id.empty()) return nullptr;
+    Queue& queue = queues_[static_cast<std::size_t>(q)];
+    auto it = queue.index.find(redemption_id);
+    if (it == queue.index.end()) return nullptr;
+
+    const std::uint32_t i = it->second;
+    RecordPtr rec = slots_[i].rec;
+    Release(queue, i);
+    return rec;
+}
+
+bool TwitchChannelPointsStore::Erase(RedemptionQueue q, const std::string& redemption_id) {
+    return Take(q, redemption_id) != nullptr;
+}
+
+std::size_t TwitchChannelPointsStore::Size(RedemptionQueue q) const {
+    return queues_[static_cast<std::size_t>(q)].size;
+}
+
+nlohmann::json TwitchChannelPointsStore::QueueJson(RedemptionQueue q, int limit) const {
+    const Queue& queue = queues_[static_cast<std::size_t>(q)];
+    limit = std::max(1, std::min(limit, 1000));
+
+    nlohmann::json out;
+    out["ok"] = true;
+    out["count"] = (int)queue.size;
+    out["events"] = nlohmann::json::array();
+
+    // Walk back from the newest entry, then emit oldest first.
+    std::vector<std::uint32_t> picked;
+    picked.reserve(std::min<std::size_t>((std::size_t)limit, queue.size));
+    for (std::uint32_t i = queue.tail; i != kNil && picked.size() < (std::size_t)limit; i = slots_[i].prev) {
+        picked.push_back(i);
+    }
+    for (auto it = picked.rbegin(); it != picked.rend(); ++it) {
+        const Slot& s = slots_[*it];
+        out["events"].push_back(ItemJson(*s.rec, q, s.history_ts_ms));
+    }
+    return out;
+}
+
+nlohmann::json TwitchChannelPointsStore::ItemJson(const ChannelPointsRedemption& rec, RedemptionQueue q, std::int64_t history_ts_ms) {
+    nlohmann::json j = (rec.payload && rec.payload->is_object()) ? *rec.payload : nlohmann::json::object();
+    j["status"] = rec.status;
+    j["delivery_mode"] = rec.delivery_mode;
+    j["client_hold"] = rec.client_hold;
+    j["app_action"] = rec.app_action ? *rec.app_action : nlohmann::json::object();
+    j["queue_state"] = QueueStateName(q);
+    if (rec.released_by_client) {
+        j["released_by_client"] = true;
+        j["released_ts_ms"] = rec.released_ts_ms;
+    }
+    if (q == RedemptionQueue::History) j["history_ts_ms"] = history_ts_ms;
+    return j;
+}
+
+} // namespace twitch
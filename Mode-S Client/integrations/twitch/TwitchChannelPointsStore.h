@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "json.hpp"
+
+namespace twitch {
+
+enum class RedemptionQueue : std::uint8_t { Pending = 0, Live, History };
+
+// One channel-points redemption. The fields the queue logic reads or changes are typed; the rest
+// of the EventSub payload is kept as received and only merged back in when a response is built.
+// Records are immutable once queued, so live and history can share one.
+struct ChannelPointsRedemption {
+    std::string redemption_id;
+    std::string status;
+    std::string delivery_mode = "immediate"; // "immediate" | "manual"
+    bool client_hold = false;
+    bool released_by_client = false;
+    std::int64_t released_ts_ms = 0;
+    std::shared_ptr<const nlohmann::json> app_action;
+    std::shared_ptr<const nlohmann::json> payload; // normalized EventSub event
+};
+
+// Pending / live / history queues of redemptions.
+//
+// Entries live in one slot array; each queue is an insertion-ordered doubly linked list through
+// the slots plus a hash index by redemption id, so upsert, take and erase are O(1). Each queue
+// keeps at most `max_per_queue` entries (oldest dropped first). Not thread-safe; AppState guards
+// it with channel_points_mu_.
+class TwitchChannelPointsStore {
+public:
+    using RecordPtr = std::shared_ptr<const ChannelPointsRedemption>;
+
+    explicit TwitchChannelPointsStore(std::size_t max_per_queue);
+
+    // Appends `rec` to `q`, replacing the entry with the same redemption id if there is one.
+    // Records without an id are appended unindexed.
+    void Upsert(RedemptionQueue q, RecordPtr rec, std::int64_t history_ts_ms = 0);
+
+    // Removes and returns the entry for `redemption_id`, or null when `q` has none.
+    RecordPtr Take(RedemptionQueue q, const std::string& redemption_id);
+    bool Erase(RedemptionQueue q, const std::string& redemption_id);
+
+    std::size_t Size(RedemptionQueue q) const;
+
+    // {"ok","count","events"} with the newest `limit` entries of `q`, oldest first.
+    nlohmann::json QueueJson(RedemptionQueue q, int limit) const;
+
+    // Response shape of one entry: the payload with the typed fields and queue_state overlaid.
+    static nlohmann::json ItemJson(const ChannelPointsRedemption& rec, RedemptionQueue q, std::int64_t history_ts_ms = 0);
+
+private:
+    static constexpr std::uint32_t kNil = 0xFFFFFFFFu;
+    static constexpr std::size_t kQueues = 3;
+
+    struct Slot {
+        RecordPtr rec;
+        std::int64_t history_ts_ms = 0;
+        std::uint32_t prev = kNil;
+        std::uint32_t next = kNil;
+    };
+
+    struct Queue {
+        std::uint32_t head = kNil; // oldest
+        std::uint32_t tail = kNil; // newest
+        std::size_t size = 0;
+        // Keys view the slot's record id, which stays alive (and unchanged) while indexed.
+        std::unordered_map<std::string_view, std::uint32_t> index;
+    };
+
+    std::uint32_t Alloc();
+    void Unlink(Queue& queue, std::uint32_t i);
+    void Release(Queue& queue, std::uint32_t i);
+
+    std::size_t max_per_queue_;
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> free_;
+    std::array<Queue, kQueues> queues_;
+};
+
+} // namespace twitch
@@ -0,0 +1,112 @@
+#include "TwitchIrcMessage.h"
+
+namespace {
+
+std::string_view FindTag(std::string_view tags, std::string_view key, bool* found)
+{
+    size_t start = 0;
+    while (start < tags.size()) {
+        size_t semi = tags.find(';', start);
+        if (semi == std::string_view::npos) semi = tags.size();
+
+        std::string_view kv = tags.substr(start, semi - start);
+        if (kv.size() >= key.size() && kv.compare(0, key.size(), key) == 0) {
+            if (kv.size() == key.size()) {
+                if (found) *found = true;
+                return {};
+            }
+            if (kv[key.size()] == '=') {
+                if (found) *found = true;
+                return kv.substr(key.size() + 1);
+            }
+        }
+        start = semi + 1;
+    }
+    if (found) *found = false;
+    return {};
+}
+
+} // namespace
+
+std::string_view TwitchIrcMessage::Tag(std::string_view key) const
+{
+    return FindTag(tags, key, nullptr);
+}
+
+bool TwitchIrcMessage::HasTag(std::string_view key) const
+{
+    bool found = false;
+    FindTag(tags, key, &found);
+    return found;
+}
+
+std::string_view TwitchIrcMessage::Nick() const
+{
+    const size_t bang = prefix.find('!');
+    return bang == std::string_view::npos ? prefix : prefix.substr(0, bang);
+}
+
+std::string_view TwitchIrcMessage::Channel() const
+{
+    std::string_view p = params.substr(0, params.find(' '));
+    if (p.empty() || p.front() != '#') return {};
+    return p.substr(1);
+}
+
+bool ParseTwitchIrcLine(std::string_view line, TwitchIrcMessage& out)
+{
+    out = TwitchIrcMessage{};
+    while (!line.empty() && (line.back() == '\r' || line.back() == '\n')) line.remove_suffix(1);
+
+    auto take_word = [&line]() {
+        const size_t sp = line.find(' ');
+        std::string_view word = line.substr(0, sp);
+        line = (sp == std::string_view::npos) ? std::string_view{} : line.substr(sp + 1);
+        while (!line.empty() && line.front() == ' ') line.remove_prefix(1);
+        return word;
+    };
+
+    if (!line.empty() && line.front() == '@') {
+        line.remove_prefix(1);
+        out.tags = take_word();
+    }
+    if (!line.empty() && line.front() == ':') {
+        line.remove_prefix(1);
+        out.prefix = take_word();
+    }
+
+    out.command = take_word();
+    if (out.command.empty()) return false;
+
+    if (!line.empty() && line.front() == ':') {
+        out.trailing = line.substr(1);
+        out.has_trailing = true;
+        return true;
+    }
+
+    const size_t colon = line.find(" :");
+    if (colon == std::string_view::npos) {
+        out.params = line;
+    }
+    else {
+        out.params = line.substr(0, colon);
+        out.trailing = line.substr(colon + 2);
+        out.has_trailing = true;
+    }
+    return true;
+}
+
+bool TwitchBadgesContain(std::string_view badges, std::string_view badge)
+{
+    size_t start = 0;
+    while (start < badges.size()) {
+        size_t comma = badges.find(',', start);
+        if (comma == std::string_view::npos) comma = badges.size();
+
+        std::string_view item = badges.substr(start, comma - start);
+        const size_t slash = item.find('/');
+        if (item.substr(0, slash) == badge) return true;
+        start = comma + 1;
+    }
+    return false;
+}
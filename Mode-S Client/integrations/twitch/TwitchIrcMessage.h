@@ -0,0 +1,34 @@
+#pragma once
+#include <string_view>
+
+// Zero-copy view of one IRC line (IRCv3 tags, prefix, command, params).
+//
+// All fields point into the line passed to ParseTwitchIrcLine(), so the line must outlive the
+// message. Tag values are returned raw (IRCv3 escapes such as "\s" are not decoded); none of the
+// tags we read use them in practice.
+struct TwitchIrcMessage {
+    std::string_view tags;     // "badge-info=;badges=...;color=#FF0000" (without '@'), may be empty
+    std::string_view prefix;   // "nick!user@host" (without ':'), may be empty
+    std::string_view command;  // "PRIVMSG", "PING", "001", ...
+    std::string_view params;   // middle params, e.g. "#channel"
+    std::string_view trailing; // text after " :", e.g. the chat message
+    bool has_trailing = false;
+
+    // Raw value of a tag, or an empty view when absent. Scans the tag list; the lines we
+    // care about carry ~20 tags, so this beats building a map for the handful we read.
+    std::string_view Tag(std::string_view key) const;
+    bool HasTag(std::string_view key) const;
+
+    // Nick from the prefix ("nick!user@host" -> "nick").
+    std::string_view Nick() const;
+
+    // Channel from the first param ("#channel" -> "channel"), empty when there is none.
+    std::string_view Channel() const;
+};
+
+// Splits a line (trailing CR/LF allowed) into its parts. Never allocates.
+// Returns false for empty/garbled lines.
+bool ParseTwitchIrcLine(std::string_view line, TwitchIrcMessage& out);
+
+// True when a badges tag value ("broadcaster/1,subscriber/12") contains the given badge.
+bool TwitchBadgesContain(std::string_view badges, std::string_view badge);
@@ -3,12 +3,14 @@
 #include <cstdint>
 #include <string>
 #include <sstream>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 #include <algorithm>
+#include <charconv>
 #include <chrono>
 #include "chat/ChatAggregator.h"
 #include "log/UiLog.h"
+#include "TwitchIrcMessage.h"
 
 // ChatMessage is defined in AppState.h (shared between platform adapters).
 // Depending on include order/build layout, ChatAggregator.h may not bring it in.
@@ -29,72 +31,54 @@ static std::wstring ToW(const std::string& s) {
     MultiByteToWideChar(CP_UTF8, 0, s.c_str(), (int)s.size(), out.data(), len);
     return out;
 }
-static std::string TrimCRLF(std::string s) {
-    while (!s.empty() && (s.back() == '\r' || s.back() == '\n')) s.pop_back();
-    return s;
-}
-static std::unordered_map<std::string, std::string> ParseTags(const std::string& tagsPart) {
-    // tagsPart: "badge-info=;badges=;client-nonce=...;display-name=Foo;..."
-    std::unordered_map<std::string, std::string> tags;
-    size_t start = 0;
-    while (start < tagsPart.size()) {
-        size_t semi = tagsPart.find(';', start);
-        std::string kv = (semi == std::string::npos) ? tagsPart.substr(start) : tagsPart.substr(start, semi - start);
-        size_t eq = kv.find('=');
-        if (eq != std::string::npos) tags[kv.substr(0, eq)] = kv.substr(eq + 1);
-        else tags[kv] = "";
-        if (semi == std::string::npos) break;
-        start = semi + 1;
-    }
-    return tags;
-}
 struct TwitchEmoteSpan {
-    std::string id;
+    std::string_view id;
     size_t start = 0;
     size_t end = 0; // inclusive
 };
 
-static std::vector<TwitchEmoteSpan> ParseTwitchEmoteSpans(const std::string& emotesTag) {
+static bool ParseSize(std::string_view s, size_t& out) {
+    if (s.empty()) return false;
+    const auto r = std::from_chars(s.data(), s.data() + s.size(), out);
+    return r.ec == std::errc() && r.ptr == s.data() + s.size();
+}
+
+static std::vector<TwitchEmoteSpan> ParseTwitchEmoteSpans(std::string_view emotesTag) {
     // Twitch IRC format: 25:0-4,12-16/1902:6-10
     std::vector<TwitchEmoteSpan> out;
     size_t groupStart = 0;
     while (groupStart < emotesTag.size()) {
         size_t slash = emotesTag.find('/', groupStart);
-        std::string group = (slash == std::string::npos)
-            ? emotesTag.substr(groupStart)
-            : emotesTag.substr(groupStart, slash - groupStart);
+        std::string_view group = emotesTag.substr(groupStart,
+            slash == std::string_view::npos ? std::string_view::npos : slash - groupStart);
 
         size_t colon = group.find(':');
-        if (colon != std::string::npos && colon > 0 && colon + 1 < group.size()) {
-            std::string emoteId = group.substr(0, colon);
-            std::string ranges = group.substr(colon + 1);
+        if (colon != std::string_view::npos && colon > 0 && colon + 1 < group.size()) {
+            std::string_view emoteId = group.substr(0, colon);
+            std::string_view ranges = group.substr(colon + 1);
 
             size_t rangeStart = 0;
             while (rangeStart < ranges.size()) {
                 size_t comma = ranges.find(',', rangeStart);
-                std::string range = (comma == std::string::npos)
-                    ? ranges.substr(rangeStart)
-                    : ranges.substr(rangeStart, comma - rangeStart);
+                std::string_view range = ranges.substr(rangeStart,
+                    comma == std::string_view::npos ? std::string_view::npos : comma - rangeStart);
 
                 size_t dash = range.find('-');
-                if (dash != std::string::npos && dash > 0 && dash + 1 < range.size()) {
-                    try {
-                        size_t start = (size_t)std::stoul(range.substr(0, dash));
-                        size_t end = (size_t)std::stoul(range.substr(dash + 1));
-                        if (end >= start) {
-                            out.push_back(TwitchEmoteSpan{ emoteId, start, end });
-                        }
-                    }
-                    catch (...) {
-                    }
+                size_t start = 0;
+                size_t end = 0;
+                if (dash != std::string_view::npos &&
+                    ParseSize(range.substr(0, dash), start) &&
+                    ParseSize(range.substr(dash + 1), end) &&
+                    end >= start) {
+                    out.push_back(TwitchEmoteSpan{ emoteId, start, end });
                 }
 
-                if (comma == std::string::npos) break;
+                if (comma == std::string_view::npos) break;
                 rangeStart = comma + 1;
             }
         }
 
-        if (slash == std::string::npos) break;
+        if (slash == std::string_view::npos) break;
         groupStart = slash + 1;
     }
 
@@ -106,7 +90,7 @@ static std::vector<TwitchEmoteSpan> ParseTwitchEmoteSpans(const std::string& emo
     return out;
 }
 
-static nlohmann::json BuildTwitchRuns(const std::string& msg, const std::string& emotesTag) {
+static nlohmann::json BuildTwitchRuns(const std::string& msg, std::string_view emotesTag) {
     nlohmann::json runs = nlohmann::json::array();
     if (msg.empty() || emotesTag.empty()) return runs;
 
@@ -127,12 +111,13 @@ static nlohmann::json BuildTwitchRuns(const std::string& msg, const std::string&
         const size_t len = span.end - span.start + 1;
         const std::string shortcut = msg.substr(span.start, len);
 
+        const std::string id(span.id);
         runs.push_back({
             {"t", "emoji"},
             {"provider", "twitch"},
-            {"id", span.id},
+            {"id", id},
             {"shortcut", shortcut},
-            {"url", "https://static-cdn.jtvnw.net/emoticons/v2/" + span.id + "/default/dark/1.0"}
+            {"url", "https://static-cdn.jtvnw.net/emoticons/v2/" + id + "/default/dark/1.0"}
             });
 
         cursor = span.end + 1;
@@ -403,81 +388,62 @@ void TwitchIrcWsClient::worker(std::string oauth, std::string nick, std::string
                                 if (r != NO_ERROR) break;
                                 if (bufferType == WINHTTP_WEB_SOCKET_CLOSE_BUFFER_TYPE) break;
                                 recvBuf.append((const char*)buffer, (size_t)bytesRead);
-                                // Process complete IRC lines
+                                // Process complete IRC lines. Lines are parsed in place as string_views;
+                                // only the fields handed to ChatAggregator are copied.
+                                const std::string_view buf(recvBuf);
                                 size_t pos = 0;
                                 while (true) {
-                                    size_t eol = recvBuf.find("\n", pos);
-                                    if (eol == std::string::npos) break;
-                                    std::string line = TrimCRLF(recvBuf.substr(pos, eol - pos + 1));
+                                    size_t eol = buf.find('\n', pos);
+                                    if (eol == std::string_view::npos) break;
+                                    const std::string_view line = buf.substr(pos, eol - pos);
                                     pos = eol + 1;
+#ifdef _DEBUG
                                     {
-                                        std::wstring w = L"[TwitchChat] " + ToW(line);
+                                        std::wstring w = L"[TwitchChat] " + ToW(std::string(line));
                                         OutputDebugStringW(w.c_str());
                                     }
-                                    if (line.rfind("PING", 0) == 0) {
-                                        std::string payload = line.substr(4);
-                                        sendLine("PONG" + payload);
+#endif
+                                    TwitchIrcMessage irc;
+                                    if (!ParseTwitchIrcLine(line, irc)) continue;
+
+                                    if (irc.command == "PING") {
+                                        std::string pong = "PONG";
+                                        if (!irc.params.empty()) pong.append(" ").append(irc.params);
+                                        if (irc.has_trailing) pong.append(" :").append(irc.trailing);
+                                        sendLine(pong);
                                         continue;
                                     }
-                                    std::string tagsPart;
-                                    std::string rest = line;
-                                    if (!rest.empty() && rest[0] == '@') {
-                                        size_t sp = rest.find(' ');
-                                        if (sp != std::string::npos) {
-                                            tagsPart = rest.substr(1, sp - 1);
-                                            rest = rest.substr(sp + 1);
-                                        }
-                                    }
-                                    auto privPos = rest.find(" PRIVMSG ");
-                                    if (privPos == std::string::npos) continue;
-                                    size_t msgPos = rest.find(" :");
-                                    if (msgPos == std::string::npos) continue;
-                                    std::string msg = rest.substr(msgPos + 2);
-                                    std::string user = "unknown";
-                                    std::string userColor;
-                                    std::unordered_map<std::string, std::string> tags; // <-- add
-                                    bool haveTags = false;                              // <-- add
-                                    if (!tagsPart.empty()) {
-                                        tags = ParseTags(tagsPart);                      // <-- change (was: auto tags = ...)
-                                        haveTags = true;                                // <-- add
-                                        auto it = tags.find("display-name");
-                                        if (it != tags.end() && !it->second.empty()) user = it->second;
-                                        auto itc = tags.find("color");
-                                        if (itc != tags.end() && !itc->second.empty()) userColor = itc->second;
-                                    }
-                                    else {
-                                        if (!rest.empty() && rest[0] == ':') {
-                                            size_t bang = rest.find('!');
-                                            if (bang != std::string::npos) user = rest.substr(1, bang - 1);
-                                        }
-                                    }
+                                    if (irc.command != "PRIVMSG" || !irc.has_trailing) continue;
+
                                     // -------------------------------------------------------------
                                     // Suppress IRC cheer messages (handled via EventSub channel.cheer)
                                     // -------------------------------------------------------------
-                                    if (haveTags) {
-                                        auto itBits = tags.find("bits");
-                                        if (itBits != tags.end()) {
-                                            int bits = 0;
-                                            try { bits = std::stoi(itBits->second); }
-                                            catch (...) { bits = 0; }
-                                            if (bits > 0) {
-                                                continue; // <-- skip this PRIVMSG line
-                                            }
-                                        }
+                                    size_t bits = 0;
+                                    if (ParseSize(irc.Tag("bits"), bits) && bits > 0) {
+                                        continue; // <-- skip this PRIVMSG line
                                     }
+
+                                    std::string_view userView = irc.Tag("display-name");
+                                    if (userView.empty()) userView = irc.Nick();
+                                    const std::string user = userView.empty() ? std::string("unknown") : std::string(userView);
+                                    std::string msg(irc.trailing);
+
                                     if (m_chat) {
+                                        const std::string_view badges = irc.Tag("badges");
+
                                         ChatMessage m{};
                                         m.platform = "twitch";
+                                        m.channel = std::string(irc.Channel());
                                         m.user = user;
                                         m.message = msg;
-                                        m.color = userColor;
+                                        m.color = std::string(irc.Tag("color"));
+                                        m.is_broadcaster = TwitchBadgesContain(badges, "broadcaster");
+                                        m.is_mod = irc.Tag("mod") == "1" || TwitchBadgesContain(badges, "moderator");
                                         m.ts_ms = NowMs();
 
-                                        if (haveTags) {
-                                            auto itEmotes = tags.find("emotes");
-                                            if (itEmotes != tags.end() && !itEmotes->second.empty()) {
-                                                m.runs = BuildTwitchRuns(msg, itEmotes->second);
-                                            }
+                                        const std::string_view emotes = irc.Tag("emotes");
+                                        if (!emotes.empty()) {
+                                            m.runs = BuildTwitchRuns(msg, emotes);
                                         }
 
                                         m_chat->Add(std::move(m));
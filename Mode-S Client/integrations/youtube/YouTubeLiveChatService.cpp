@@ -234,10 +234,14 @@ static bool TryGetActiveYouTubeLiveChatId(const std::string& accessToken,
     }
 }
 
+// `outUncertain` is set when the POST got no response although it may have reached YouTube
+// (timeout, dropped connection): liveChatMessages.insert is not idempotent, so such a send
+// must not be repeated.
 static bool TryPostYouTubeLiveChatMessage(const std::string& accessToken,
     const std::string& liveChatId,
     const std::string& text,
-    std::string* outError)
+    std::string* outError,
+    bool* outUncertain = nullptr)
 {
     if (accessToken.empty()) {
         if (outError) *outError = "YouTube access token missing";
@@ -276,6 +280,13 @@ static bool TryPostYouTubeLiveChatMessage(const std::string& accessToken,
         return true;
     }
 
+    if (r.status == 0 && outUncertain) {
+        // These fail before the request body is sent; anything else may have been delivered.
+        *outUncertain = r.winerr != ERROR_WINHTTP_NAME_NOT_RESOLVED &&
+            r.winerr != ERROR_WINHTTP_CANNOT_CONNECT &&
+            r.winerr != ERROR_WINHTTP_SECURE_FAILURE;
+    }
+
     if (outError) {
         *outError = "liveChatMessages.insert failed: HTTP " + std::to_string(r.status);
         if (!r.body.empty()) *outError += " body=" + r.body;
@@ -960,8 +971,10 @@ void YouTubeLiveChatService::SetReplyAuth(YouTubeAuth* auth) {
     reply_auth_ = auth;
 }
 
-bool YouTubeLiveChatService::send_chat(const std::string& text, std::string* out_error)
+bool YouTubeLiveChatService::send_chat(const std::string& text, std::string* out_error, bool* out_uncertain)
 {
+    if (out_uncertain) *out_uncertain = false;
+
     YouTubeAuth* auth = nullptr;
     {
         std::lock_guard<std::mutex> lk(reply_mu_);
@@ -1002,7 +1015,7 @@ bool YouTubeLiveChatService::send_chat(const std::string& text, std::string* out
     }
 
     std::string sendError;
-    if (TryPostYouTubeLiveChatMessage(*tokenOpt, liveChatId, text, &sendError)) {
+    if (TryPostYouTubeLiveChatMessage(*tokenOpt, liveChatId, text, &sendError, out_uncertain)) {
         return true;
     }
 
@@ -1012,7 +1025,7 @@ bool YouTubeLiveChatService::send_chat(const std::string& text, std::string* out
         std::string refreshedLiveChatId;
         std::string resolveError;
         if (TryGetActiveYouTubeLiveChatId(*tokenOpt, refreshedLiveChatId, &resolveError) &&
-            TryPostYouTubeLiveChatMessage(*tokenOpt, refreshedLiveChatId, text, &sendError)) {
+            TryPostYouTubeLiveChatMessage(*tokenOpt, refreshedLiveChatId, text, &sendError, out_uncertain)) {
             std::lock_guard<std::mutex> lk(reply_mu_);
             cached_reply_live_chat_id_ = refreshedLiveChatId;
             cached_reply_live_chat_id_ms_ = nowMs;
@@ -1137,6 +1150,7 @@ void YouTubeLiveChatService::worker(std::string handleIn, ChatAggregator* chat,
         ExtractChatMessages(j, msgs);
         Log(L"YOUTUBE: extracted " + std::to_wstring((unsigned long long)msgs.size()) + L" chat messages");
         for (auto& m : msgs) {
+            m.channel = handle;
             if (chat) chat->Add(std::move(m));
         }
 
@@ -25,7 +25,8 @@ public:
         AppState* state = nullptr);
 
     void SetReplyAuth(YouTubeAuth* auth);
-    bool send_chat(const std::string& text, std::string* out_error = nullptr);
+    // `out_uncertain` is set on failures where the message may still have been posted.
+    bool send_chat(const std::string& text, std::string* out_error = nullptr, bool* out_uncertain = nullptr);
 
     void stop();
     bool running() const { return running_.load(); }
@@ -21,6 +21,7 @@ struct AppConfig
     std::string tiktok_sessionid;
     std::string tiktok_sessionid_ss;
     std::string tiktok_tt_target_idc;
+    int         log_capacity = 100000; // lines kept for the Web UI log (/api/log); read-only setting
 
     static std::wstring GetExeDir()
     {
@@ -133,6 +134,7 @@ bool Load()
         overlay_font_family = j.value("overlay_font_family", overlay_font_family);
         overlay_font_size = j.value("overlay_font_size", overlay_font_size);
         overlay_text_shadow = j.value("overlay_text_shadow", overlay_text_shadow);
+        log_capacity = j.value("log_capacity", log_capacity);
         return true;
         }
         catch (...) {
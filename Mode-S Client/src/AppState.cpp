@@ -4,6 +4,8 @@
 #include <fstream>
 #include <filesystem>
 
+#include "core/ConfigWriteBehind.h"
+
 static bool AtomicWriteUtf8File(const std::string& path_utf8, const std::string& content);
 
 static std::string ToLower(std::string s) {
@@ -31,53 +33,88 @@ static std::string JsonStringField(const nlohmann::json& obj, const char* key, c
     return fallback;
 }
 
-static std::string ChannelPointsRedemptionId(const nlohmann::json& j) {
-    std::string id = JsonStringField(j, "redemption_id");
-    if (id.empty()) id = JsonStringField(j, "id");
-    return id;
-}
+// [begin, end) of the events a feed poll returns. Entries are in ascending seq order, so the
+// first event newer than `since` is a binary search and the cost is the number returned.
+template <typename Feed>
+static std::pair<std::size_t, std::size_t> FeedWindow(const Feed& feed, std::uint64_t since, std::size_t limit) {
+    const std::size_t n = feed.size();
+    if (since == 0) return { n > limit ? n - limit : 0, n };
 
-static void EraseChannelPointsByRedemptionId(std::deque<nlohmann::json>& q, const std::string& redemption_id) {
-    if (redemption_id.empty()) return;
-    q.erase(
-        std::remove_if(q.begin(), q.end(), [&](const nlohmann::json& item) {
-            return ChannelPointsRedemptionId(item) == redemption_id;
-            }),
-        q.end());
+    const auto first = std::upper_bound(feed.begin(), feed.end(), since,
+        [](std::uint64_t s, const typename Feed::value_type& e) { return s < e.seq; });
+    const std::size_t begin = (std::size_t)(first - feed.begin());
+    return { begin, std::min(n, begin + limit) };
 }
 
-static nlohmann::json TakeChannelPointsByRedemptionId(std::deque<nlohmann::json>& q, const std::string& redemption_id) {
-    if (redemption_id.empty()) return nlohmann::json();
-    for (auto it = q.begin(); it != q.end(); ++it) {
-        if (ChannelPointsRedemptionId(*it) == redemption_id) {
-            nlohmann::json out = *it;
-            q.erase(it);
-            return out;
+// Feed/bus payload of a TikTok or YouTube event; "seq" is added when the event is pushed.
+static nlohmann::json EventItemJson(const EventItem& e) {
+    nlohmann::json j;
+    j["platform"] = e.platform;
+    j["type"] = e.type;
+    j["user"] = e.user;
+    j["message"] = e.message;
+    j["ts_ms"] = e.ts_ms;
+
+    if (e.data.is_object()) {
+        for (auto it = e.data.begin(); it != e.data.end(); ++it) {
+            if (!j.contains(it.key())) {
+                j[it.key()] = it.value();
+            }
         }
     }
-    return nlohmann::json();
+    return j;
 }
 
-static void PushBoundedJson(std::deque<nlohmann::json>& q, const nlohmann::json& item, std::size_t max_items) {
-    q.push_back(item);
-    while (q.size() > max_items) q.pop_front();
+std::int64_t AppState::now_ms() {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
 }
 
-static void UpsertChannelPointsByRedemptionId(std::deque<nlohmann::json>& q, const nlohmann::json& item, std::size_t max_items) {
-    const std::string redemption_id = ChannelPointsRedemptionId(item);
-    if (!redemption_id.empty()) {
-        EraseChannelPointsByRedemptionId(q, redemption_id);
-    }
-    PushBoundedJson(q, item, max_items);
+std::uint64_t AppState::version(Domain d) const {
+    return versions_[(std::size_t)d].load(std::memory_order_acquire);
 }
 
-std::int64_t AppState::now_ms() {
-    using namespace std::chrono;
-    return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+void AppState::bump_version(Domain d) {
+    versions_[(std::size_t)d].fetch_add(1, std::memory_order_acq_rel);
+}
+
+nlohmann::json AppState::lock_stats_json() const {
+    auto entry = [](const ContendedMutex& mu) {
+        const std::uint64_t n = mu.acquisitions();
+        const std::uint64_t c = mu.contended();
+        return nlohmann::json{
+            {"acquisitions", n},
+            {"contended", c},
+            {"contended_pct", n ? (double)c * 100.0 / (double)n : 0.0},
+            {"wait_us", mu.wait_us()}
+        };
+    };
+
+    return nlohmann::json{
+        {"metrics", entry(metrics_mu_)},
+        {"platform_status", entry(platform_mu_)},
+        {"chat", entry(chat_mu_)},
+        {"twitch_eventsub", entry(eventsub_mu_)},
+        {"channel_points", entry(channel_points_mu_)},
+        {"tiktok_events", entry(tiktok_mu_)},
+        {"youtube_events", entry(youtube_mu_)},
+        {"euroscope_tag_events", entry(euroscope_mu_)},
+        {"alerts_history", entry(alerts_history_mu_)},
+        {"bot_commands", entry(bot_cmds_mu_)},
+        {"bot_settings", entry(bot_settings_mu_)},
+        {"overlay_header", entry(overlay_header_mu_)},
+        {"stream_draft", entry(stream_draft_mu_)}
+    };
 }
 
-std::string AppState::make_alert_history_id_(std::uint64_t seq) {
-    return std::string("hist-") + std::to_string(seq);
+bool AppState::open_alerts_history_log(const std::string& dir_utf8, std::size_t* loaded, std::string* err) {
+    bool ok = false;
+    {
+        std::lock_guard<ContendedMutex> lk(alerts_history_mu_);
+        ok = alerts_history_.Open(std::filesystem::u8path(dir_utf8), loaded, err);
+    }
+    if (ok) bump_version(Domain::AlertsHistory);
+    return ok;
 }
 
 void AppState::record_alert_history_(const nlohmann::json& payload_in) {
@@ -109,58 +146,54 @@ void AppState::record_alert_history_(const nlohmann::json& payload_in) {
     }
     if (!payload.contains("message")) payload["message"] = "";
 
-    AlertHistoryItem item;
     {
-        std::lock_guard<std::mutex> lk(alerts_history_mu_);
-        item.history_id = make_alert_history_id_(++alerts_history_seq_);
+        std::lock_guard<ContendedMutex> lk(alerts_history_mu_);
+        alerts_history_.Append(std::move(payload), platform);
     }
-    item.payload = payload;
-    item.platform = platform;
-    item.ts_ms = payload.value("ts_ms", (std::int64_t)0);
+    bump_version(Domain::AlertsHistory);
+}
 
-    {
-        std::lock_guard<std::mutex> lk(alerts_history_mu_);
-        alerts_history_.push_back(std::move(item));
-        while (alerts_history_.size() > kAlertsHistoryMax_) alerts_history_.pop_front();
-    }
+std::uint64_t AppState::subscribe_support_events(std::string name, SupportEventBus::Handler handler) {
+    return support_events_.Subscribe(std::move(name), std::move(handler));
 }
 
-nlohmann::json AppState::alerts_history_json(int limit, const std::string& platform_filter) const {
-    int lim = std::max(1, std::min(5000, limit));
-    std::string pf = platform_filter;
-    pf = ToLower(pf);
+void AppState::unsubscribe_support_events(std::uint64_t id) {
+    support_events_.Unsubscribe(id);
+}
 
-    nlohmann::json out;
-    out["ok"] = true;
-    out["events"] = nlohmann::json::array();
+nlohmann::json AppState::support_event_subscribers_json() const {
+    return support_events_.StatsJson();
+}
 
-    std::lock_guard<std::mutex> lk(alerts_history_mu_);
+void AppState::publish_support_event_(SupportPlatform platform, std::shared_ptr<const nlohmann::json> payload) {
+    if (!payload) return;
 
-    int added = 0;
-    for (auto it = alerts_history_.rbegin(); it != alerts_history_.rend() && added < lim; ++it) {
-        if (!pf.empty() && it->platform != pf) continue;
-        nlohmann::json e = it->payload;
-        e["history_id"] = it->history_id;
-        out["events"].push_back(std::move(e));
-        added++;
+    SupportEvent ev;
+    ev.platform = platform;
+    if (payload->is_object()) {
+        ev.seq = payload->value("seq", (std::uint64_t)0);
+        ev.type = JsonStringField(*payload, "type");
+        ev.ts_ms = payload->value("ts_ms", (std::int64_t)0);
     }
-    out["count"] = added;
-    return out;
+    ev.payload = std::move(payload);
+    support_events_.Publish(ev);
+}
+
+std::string AppState::alerts_history_json(int limit, const std::string& platform_filter,
+                                          std::uint64_t before, std::uint64_t after) const {
+    const std::string pf = ToLower(platform_filter);
+    std::lock_guard<ContendedMutex> lk(alerts_history_mu_);
+    return alerts_history_.PageJson(limit, pf, before, after);
 }
 
 bool AppState::resend_alert_history(const std::string& history_id, nlohmann::json* replayed, std::string* err) {
-    AlertHistoryItem found;
+    nlohmann::json found;
     bool ok = false;
+    const std::uint64_t seq = alerts::AlertHistoryStore::ParseHistoryId(history_id);
 
-    {
-        std::lock_guard<std::mutex> lk(alerts_history_mu_);
-        for (const auto& it : alerts_history_) {
-            if (it.history_id == history_id) {
-                found = it;
-                ok = true;
-                break;
-            }
-        }
+    if (seq > 0) {
+        std::lock_guard<ContendedMutex> lk(alerts_history_mu_);
+        ok = alerts_history_.Find(seq, &found);
     }
 
     if (!ok) {
@@ -168,8 +201,7 @@ bool AppState::resend_alert_history(const std::string& history_id, nlohmann::jso
         return false;
     }
 
-    
-    nlohmann::json replay = found.payload;
+    nlohmann::json replay = std::move(found);
     if (replay.is_array()) {
         if (replay.empty() || !replay[0].is_object()) {
             if (err) *err = "invalid_payload";
@@ -177,6 +209,8 @@ bool AppState::resend_alert_history(const std::string& history_id, nlohmann::jso
         }
         replay = replay[0];
     }
+    replay.erase("history_id");
+    replay.erase("history_seq");
 const auto ts = now_ms();
     replay["ts_ms"] = ts;
     // Force a fresh id so client-side de-dupe won't ignore it.
@@ -227,16 +261,12 @@ const auto ts = now_ms();
 
 
 
-void AppState::load_metrics_cache_from_config_unlocked()
+void AppState::load_metrics_cache_from_config()
 {
-    if (metrics_cache_loaded_) return;
-    metrics_cache_loaded_ = true;
-
     try {
         const auto path = std::filesystem::absolute("config.json");
         std::ifstream in(path, std::ios::binary);
         if (!in) return;
-
         std::string s((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
         if (s.empty()) return;
 
@@ -246,134 +276,160 @@ void AppState::load_metrics_cache_from_config_unlocked()
         if (!j.contains("metrics_cache") || !j["metrics_cache"].is_object()) return;
         const auto& mc = j["metrics_cache"];
 
-        // Only hydrate persisted counts (viewers/live are ephemeral)
-        metrics_.twitch_followers = mc.value("twitch_followers", metrics_.twitch_followers);
-        metrics_.twitch_subscribers = mc.value("twitch_subscribers", metrics_.twitch_subscribers);
-        metrics_.tiktok_followers = mc.value("tiktok_followers", metrics_.tiktok_followers);
-        metrics_.youtube_followers = mc.value("youtube_followers", metrics_.youtube_followers);
+        {
+            std::lock_guard<ContendedMutex> lk(metrics_mu_);
+
+            // Only hydrate persisted counts (viewers/live are ephemeral)
+            metrics_.twitch_followers = mc.value("twitch_followers", metrics_.twitch_followers);
+            metrics_.twitch_subscribers = mc.value("twitch_subscribers", metrics_.twitch_subscribers);
+            metrics_.tiktok_followers = mc.value("tiktok_followers", metrics_.tiktok_followers);
+            metrics_.youtube_followers = mc.value("youtube_followers", metrics_.youtube_followers);
 
-        // Optional: carry timestamp forward for UI freshness display
-        metrics_.ts_ms = mc.value("ts_ms", metrics_.ts_ms);
+            // Optional: carry timestamp forward for UI freshness display
+            metrics_.ts_ms = mc.value("ts_ms", metrics_.ts_ms);
+            metrics_snapshot_.Store(metrics_);
+        }
+        bump_version(Domain::Metrics);
     }
     catch (...) {
         // best-effort
     }
 }
 
-void AppState::save_metrics_cache_to_config_unlocked()
+void AppState::save_metrics_cache_to_config(const Metrics& m)
 {
-    // Debounce disk writes (followers can update frequently)
-    const std::int64_t now = now_ms();
-    if (now - last_metrics_cache_save_ms_ < 5000) return; // 5 seconds
-    last_metrics_cache_save_ms_ = now;
-
-    try {
-        const auto path = std::filesystem::absolute("config.json");
-
-        nlohmann::json j = nlohmann::json::object();
-
-        // Load existing config so we don't clobber secrets/other settings.
-        {
-            std::ifstream in(path, std::ios::binary);
-            if (in) {
-                std::string s((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
-                if (!s.empty()) {
-                    j = nlohmann::json::parse(s);
-                    if (!j.is_object()) j = nlohmann::json::object();
-                }
-            }
-        }
-
-        j["metrics_cache"] = nlohmann::json{
-            {"ts_ms", now},
-            {"twitch_followers",  metrics_.twitch_followers},
-            {"twitch_subscribers", metrics_.twitch_subscribers},
-            {"tiktok_followers",  metrics_.tiktok_followers},
-            {"youtube_followers", metrics_.youtube_followers}
-        };
-
-        // Use existing atomic writer helper (already in this file).
-        AtomicWriteUtf8File(path.u8string(), j.dump(2));
-    }
-    catch (...) {
-        // best-effort
-    }
+    // Coalesced with other pending metrics saves and written by the config writer thread.
+    SharedConfigWriter().Set(std::filesystem::absolute("config.json"), "/metrics_cache", nlohmann::json{
+        {"ts_ms", now_ms()},
+        {"twitch_followers",  m.twitch_followers},
+        {"twitch_subscribers", m.twitch_subscribers},
+        {"tiktok_followers",  m.tiktok_followers},
+        {"youtube_followers", m.youtube_followers}
+    });
 }
 
 std::vector<ChatMessage> AppState::recent_chat() const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(chat_mu_);
     return std::vector<ChatMessage>(chat_.begin(), chat_.end());
 }
 
 void AppState::set_tiktok_viewers(int v) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    metrics_.ts_ms = now_ms();
-    metrics_.tiktok_viewers = v;
+    {
+        std::lock_guard<ContendedMutex> lk(metrics_mu_);
+        if (metrics_.tiktok_viewers == v) return;
+        metrics_.ts_ms = now_ms();
+        metrics_.tiktok_viewers = v;
+        metrics_snapshot_.Store(metrics_);
+    }
+    bump_version(Domain::Metrics);
 }
 void AppState::set_tiktok_followers(int f) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    load_metrics_cache_from_config_unlocked();
-    if (metrics_.tiktok_followers == f) return;
-    metrics_.ts_ms = now_ms();
-    metrics_.tiktok_followers = f;
-    save_metrics_cache_to_config_unlocked();
+    Metrics persist;
+    {
+        std::lock_guard<ContendedMutex> lk(metrics_mu_);
+        if (metrics_.tiktok_followers == f) return;
+        metrics_.ts_ms = now_ms();
+        metrics_.tiktok_followers = f;
+        metrics_snapshot_.Store(metrics_);
+        persist = metrics_;
+    }
+    bump_version(Domain::Metrics);
+    save_metrics_cache_to_config(persist);
 }
 void AppState::set_tiktok_live(bool live) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    metrics_.ts_ms = now_ms();
-    metrics_.tiktok_live = live;
+    {
+        std::lock_guard<ContendedMutex> lk(metrics_mu_);
+        if (metrics_.tiktok_live == live) return;
+        metrics_.ts_ms = now_ms();
+        metrics_.tiktok_live = live;
+        metrics_snapshot_.Store(metrics_);
+    }
+    bump_version(Domain::Metrics);
 }
 
 void AppState::set_twitch_viewers(int v) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    metrics_.ts_ms = now_ms();
-    metrics_.twitch_viewers = v;
+    {
+        std::lock_guard<ContendedMutex> lk(metrics_mu_);
+        if (metrics_.twitch_viewers == v) return;
+        metrics_.ts_ms = now_ms();
+        metrics_.twitch_viewers = v;
+        metrics_snapshot_.Store(metrics_);
+    }
+    bump_version(Domain::Metrics);
 }
 void AppState::set_twitch_followers(int f) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    load_metrics_cache_from_config_unlocked();
-    if (metrics_.twitch_followers == f) return;
-    metrics_.ts_ms = now_ms();
-    metrics_.twitch_followers = f;
-    save_metrics_cache_to_config_unlocked();
+    Metrics persist;
+    {
+        std::lock_guard<ContendedMutex> lk(metrics_mu_);
+        if (metrics_.twitch_followers == f) return;
+        metrics_.ts_ms = now_ms();
+        metrics_.twitch_followers = f;
+        metrics_snapshot_.Store(metrics_);
+        persist = metrics_;
+    }
+    bump_version(Domain::Metrics);
+    save_metrics_cache_to_config(persist);
 }
 void AppState::set_twitch_subscribers(int c) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    load_metrics_cache_from_config_unlocked();
-    if (metrics_.twitch_subscribers == c) return;
-    metrics_.ts_ms = now_ms();
-    metrics_.twitch_subscribers = c;
-    save_metrics_cache_to_config_unlocked();
+    Metrics persist;
+    {
+        std::lock_guard<ContendedMutex> lk(metrics_mu_);
+        if (metrics_.twitch_subscribers == c) return;
+        metrics_.ts_ms = now_ms();
+        metrics_.twitch_subscribers = c;
+        metrics_snapshot_.Store(metrics_);
+        persist = metrics_;
+    }
+    bump_version(Domain::Metrics);
+    save_metrics_cache_to_config(persist);
 }
 void AppState::set_twitch_live(bool live) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    metrics_.ts_ms = now_ms();
-    metrics_.twitch_live = live;
+    {
+        std::lock_guard<ContendedMutex> lk(metrics_mu_);
+        if (metrics_.twitch_live == live) return;
+        metrics_.ts_ms = now_ms();
+        metrics_.twitch_live = live;
+        metrics_snapshot_.Store(metrics_);
+    }
+    bump_version(Domain::Metrics);
 }
 
 void AppState::set_youtube_viewers(int v) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    metrics_.ts_ms = now_ms();
-    metrics_.youtube_viewers = v;
+    {
+        std::lock_guard<ContendedMutex> lk(metrics_mu_);
+        if (metrics_.youtube_viewers == v) return;
+        metrics_.ts_ms = now_ms();
+        metrics_.youtube_viewers = v;
+        metrics_snapshot_.Store(metrics_);
+    }
+    bump_version(Domain::Metrics);
 }
 void AppState::set_youtube_followers(int f) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    load_metrics_cache_from_config_unlocked();
-    if (metrics_.youtube_followers == f) return;
-    metrics_.ts_ms = now_ms();
-    metrics_.youtube_followers = f;
-    save_metrics_cache_to_config_unlocked();
+    Metrics persist;
+    {
+        std::lock_guard<ContendedMutex> lk(metrics_mu_);
+        if (metrics_.youtube_followers == f) return;
+        metrics_.ts_ms = now_ms();
+        metrics_.youtube_followers = f;
+        metrics_snapshot_.Store(metrics_);
+        persist = metrics_;
+    }
+    bump_version(Domain::Metrics);
+    save_metrics_cache_to_config(persist);
 }
 void AppState::set_youtube_live(bool live) {
-    std::lock_guard<std::mutex> lk(mtx_);
-    metrics_.ts_ms = now_ms();
-    metrics_.youtube_live = live;
+    {
+        std::lock_guard<ContendedMutex> lk(metrics_mu_);
+        if (metrics_.youtube_live == live) return;
+        metrics_.ts_ms = now_ms();
+        metrics_.youtube_live = live;
+        metrics_snapshot_.Store(metrics_);
+    }
+    bump_version(Domain::Metrics);
 }
 
 Metrics AppState::get_metrics() const {
-    std::lock_guard<std::mutex> lk(mtx_);
-    const_cast<AppState*>(this)->load_metrics_cache_from_config_unlocked();
-    return metrics_;
+    return metrics_snapshot_.Load();
 }
 
 nlohmann::json AppState::metrics_json() const {
@@ -396,7 +452,7 @@ nlohmann::json AppState::metrics_json() const {
 }
 
 void AppState::set_platform_runtime_state(const std::string& platform, const std::string& requested_state) {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(platform_mu_);
 
     if (!platform_runtime_state_.is_object()) {
         platform_runtime_state_ = nlohmann::json::object();
@@ -411,10 +467,11 @@ void AppState::set_platform_runtime_state(const std::string& platform, const std
         {"requested_state", requested_state},
         {"ts_ms", now_ms()}
     };
+    bump_version(Domain::PlatformStatus);
 }
 
 nlohmann::json AppState::platform_runtime_state_json() const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(platform_mu_);
     nlohmann::json out = platform_runtime_state_;
     if (!out.is_object()) {
         out = nlohmann::json::object();
@@ -447,12 +504,12 @@ nlohmann::json AppState::chat_json() const {
 
 // --- Twitch EventSub diagnostics ---
 void AppState::set_twitch_eventsub_status(const nlohmann::json& status) {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(eventsub_mu_);
     twitch_eventsub_status_ = status;
 }
 
 nlohmann::json AppState::twitch_eventsub_status_json() const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(eventsub_mu_);
     nlohmann::json j = twitch_eventsub_status_;
 
     // Derived health signal: "healthy" means we are connected, subscribed, and have seen a keepalive/message
@@ -502,13 +559,22 @@ void AppState::add_twitch_eventsub_event(const nlohmann::json& ev) {
     catch (...) {
     }
 
-    std::lock_guard<std::mutex> lk(mtx_);
-
-    twitch_eventsub_events_.push_back(ev);
+    auto payload = std::make_shared<nlohmann::json>(ev);
+    {
+        std::lock_guard<ContendedMutex> lk(eventsub_mu_);
+        FeedEventEntry entry;
+        entry.seq = next_event_feed_seq_();
+        if (payload->is_object()) (*payload)["seq"] = entry.seq;
+        entry.payload = payload;
+        twitch_eventsub_event_seq_ = entry.seq;
+        twitch_eventsub_events_.push_back(std::move(entry));
+        while (twitch_eventsub_events_.size() > 200) twitch_eventsub_events_.pop_front();
+    }
     if (request_subscriber_refresh) {
-        twitch_subscriber_refresh_requested_ = true;
+        twitch_subscriber_refresh_requested_.store(true);
     }
-    while (twitch_eventsub_events_.size() > 200) twitch_eventsub_events_.pop_front();
+    bump_version(Domain::TwitchEventSub);
+    publish_support_event_(SupportPlatform::Twitch, std::move(payload));
 
     const std::string type_lc = ToLower(ev.value("type", std::string{}));
     const bool is_cp_add =
@@ -540,6 +606,8 @@ void AppState::add_twitch_eventsub_event(const nlohmann::json& ev) {
     if (!cp.contains("user")) cp["user"] = "";
     if (!cp.contains("message")) cp["message"] = "";
 
+    std::lock_guard<ContendedMutex> lk(channel_points_mu_);
+
     // Load local reward action metadata if available in this working copy.
     nlohmann::json action = nlohmann::json::object();
     try {
@@ -559,128 +627,95 @@ void AppState::add_twitch_eventsub_event(const nlohmann::json& ev) {
     if (delivery_mode != "manual") delivery_mode = "immediate";
     const bool client_hold = JsonBoolLooseField(action, "client_hold", false);
 
-    cp["app_action"] = action;
-    cp["delivery_mode"] = delivery_mode;
-    cp["client_hold"] = client_hold;
+    auto rec = std::make_shared<twitch::ChannelPointsRedemption>();
+    rec->redemption_id = redemption_id;
+    rec->delivery_mode = delivery_mode;
+    rec->client_hold = client_hold;
+    rec->app_action = std::make_shared<const nlohmann::json>(std::move(action));
 
     std::string status = ToLower(cp.value("status", std::string{}));
     if (status.empty() && is_cp_add) status = "unfulfilled";
-    cp["status"] = status;
+    rec->status = status;
+    rec->payload = std::make_shared<const nlohmann::json>(std::move(cp));
+
+    const bool hold = (delivery_mode == "manual" || client_hold);
 
     if (is_cp_add) {
-        if (delivery_mode == "manual" || client_hold) {
-            cp["queue_state"] = "pending";
-            UpsertChannelPointsByRedemptionId(
-                twitch_channel_points_pending_,
-                cp,
-                kTwitchChannelPointsQueueMax_);
+        if (hold) {
+            twitch_channel_points_.Upsert(twitch::RedemptionQueue::Pending, std::move(rec));
         }
         else {
-            cp["queue_state"] = "live";
-            UpsertChannelPointsByRedemptionId(
-                twitch_channel_points_live_,
-                cp,
-                kTwitchChannelPointsQueueMax_);
-
-            nlohmann::json hist = cp;
-            hist["queue_state"] = "history";
-            hist["history_ts_ms"] = now_ms();
-            UpsertChannelPointsByRedemptionId(
-                twitch_channel_points_history_,
-                hist,
-                kTwitchChannelPointsQueueMax_);
+            twitch_channel_points_.Upsert(twitch::RedemptionQueue::Live, rec);
+            twitch_channel_points_.Upsert(twitch::RedemptionQueue::History, std::move(rec), now_ms());
         }
         return;
     }
 
     // Update flow
     if (status == "fulfilled") {
-        const nlohmann::json pending = TakeChannelPointsByRedemptionId(
-            twitch_channel_points_pending_, redemption_id);
-
-        const bool was_pending = pending.is_object();
-        if (was_pending || delivery_mode == "manual" || client_hold) {
-            nlohmann::json live_item = was_pending ? pending : cp;
-            live_item["status"] = "fulfilled";
-            live_item["queue_state"] = "live";
-            live_item["app_action"] = action;
-            live_item["delivery_mode"] = delivery_mode;
-            live_item["client_hold"] = client_hold;
-
-            UpsertChannelPointsByRedemptionId(
-                twitch_channel_points_live_,
-                live_item,
-                kTwitchChannelPointsQueueMax_);
-
-            nlohmann::json hist = live_item;
-            hist["queue_state"] = "history";
-            hist["history_ts_ms"] = now_ms();
-            UpsertChannelPointsByRedemptionId(
-                twitch_channel_points_history_,
-                hist,
-                kTwitchChannelPointsQueueMax_);
-        }
-        else {
-            // Immediate-mode redemption already fired on the initial add event.
-            EraseChannelPointsByRedemptionId(twitch_channel_points_pending_, redemption_id);
+        // Take() also drops an immediate-mode entry that (unexpectedly) sat in pending; such a
+        // redemption already fired on the initial add event.
+        const auto pending = twitch_channel_points_.Take(twitch::RedemptionQueue::Pending, redemption_id);
+        if (pending || hold) {
+            auto live_item = std::make_shared<twitch::ChannelPointsRedemption>(pending ? *pending : *rec);
+            live_item->status = "fulfilled";
+            live_item->app_action = rec->app_action;
+            live_item->delivery_mode = delivery_mode;
+            live_item->client_hold = client_hold;
+
+            twitch_channel_points_.Upsert(twitch::RedemptionQueue::Live, live_item);
+            twitch_channel_points_.Upsert(twitch::RedemptionQueue::History, std::move(live_item), now_ms());
         }
         return;
     }
 
     if (status == "canceled" || status == "cancelled") {
-        EraseChannelPointsByRedemptionId(twitch_channel_points_pending_, redemption_id);
+        twitch_channel_points_.Erase(twitch::RedemptionQueue::Pending, redemption_id);
         return;
     }
 
-    if (status == "unfulfilled" && (delivery_mode == "manual" || client_hold)) {
-        cp["queue_state"] = "pending";
-        UpsertChannelPointsByRedemptionId(
-            twitch_channel_points_pending_,
-            cp,
-            kTwitchChannelPointsQueueMax_);
+    if (status == "unfulfilled" && hold) {
+        twitch_channel_points_.Upsert(twitch::RedemptionQueue::Pending, std::move(rec));
     }
 }
 
 void AppState::request_twitch_subscriber_refresh() {
-    std::lock_guard<std::mutex> lk(mtx_);
-    twitch_subscriber_refresh_requested_ = true;
+    twitch_subscriber_refresh_requested_.store(true);
 }
 
 bool AppState::consume_twitch_subscriber_refresh_requested() {
-    std::lock_guard<std::mutex> lk(mtx_);
-    const bool requested = twitch_subscriber_refresh_requested_;
-    twitch_subscriber_refresh_requested_ = false;
-    return requested;
+    return twitch_subscriber_refresh_requested_.exchange(false);
 }
 
-nlohmann::json AppState::twitch_eventsub_events_json(int limit) const {
-    std::lock_guard<std::mutex> lk(mtx_);
+nlohmann::json AppState::twitch_eventsub_events_json(int limit, std::uint64_t since) const {
+    std::lock_guard<ContendedMutex> lk(eventsub_mu_);
     limit = std::max(1, std::min(limit, 1000));
 
     nlohmann::json out;
     out["count"] = (int)twitch_eventsub_events_.size();
     nlohmann::json arr = nlohmann::json::array();
 
-    int start = (int)twitch_eventsub_events_.size() - limit;
-    if (start < 0) start = 0;
-    for (int i = start; i < (int)twitch_eventsub_events_.size(); ++i) {
-        arr.push_back(twitch_eventsub_events_[i]);
+    const auto range = FeedWindow(twitch_eventsub_events_, since, (std::size_t)limit);
+    for (std::size_t i = range.first; i < range.second; ++i) {
+        arr.push_back(*twitch_eventsub_events_[i].payload);
     }
     out["events"] = std::move(arr);
+    out["latest_seq"] = twitch_eventsub_event_seq_;
     return out;
 }
 
 void AppState::clear_twitch_eventsub_events() {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(eventsub_mu_);
     twitch_eventsub_events_.clear();
+    bump_version(Domain::TwitchEventSub);
 }
 
 
 void AppState::push_twitch_eventsub_error(const std::string& msg) {
     if (msg.empty()) return;
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(eventsub_mu_);
     ErrorEntry e;
-    e.id = ++log_next_id_;
+    e.id = ++twitch_eventsub_error_next_id_;
     e.ts_ms = now_ms();
     e.msg = msg;
     twitch_eventsub_errors_.push_back(std::move(e));
@@ -688,7 +723,7 @@ void AppState::push_twitch_eventsub_error(const std::string& msg) {
 }
 
 nlohmann::json AppState::twitch_eventsub_errors_json(int limit) const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(eventsub_mu_);
     limit = std::max(1, std::min(limit, 1000));
 
     nlohmann::json out;
@@ -710,54 +745,18 @@ nlohmann::json AppState::twitch_eventsub_errors_json(int limit) const {
 }
 
 nlohmann::json AppState::twitch_channel_points_live_json(int limit) const {
-    std::lock_guard<std::mutex> lk(mtx_);
-    limit = std::max(1, std::min(limit, 1000));
-
-    nlohmann::json out;
-    out["ok"] = true;
-    out["count"] = (int)twitch_channel_points_live_.size();
-    out["events"] = nlohmann::json::array();
-
-    int start = (int)twitch_channel_points_live_.size() - limit;
-    if (start < 0) start = 0;
-    for (int i = start; i < (int)twitch_channel_points_live_.size(); ++i) {
-        out["events"].push_back(twitch_channel_points_live_[i]);
-    }
-    return out;
+    std::lock_guard<ContendedMutex> lk(channel_points_mu_);
+    return twitch_channel_points_.QueueJson(twitch::RedemptionQueue::Live, limit);
 }
 
 nlohmann::json AppState::twitch_channel_points_pending_json(int limit) const {
-    std::lock_guard<std::mutex> lk(mtx_);
-    limit = std::max(1, std::min(limit, 1000));
-
-    nlohmann::json out;
-    out["ok"] = true;
-    out["count"] = (int)twitch_channel_points_pending_.size();
-    out["events"] = nlohmann::json::array();
-
-    int start = (int)twitch_channel_points_pending_.size() - limit;
-    if (start < 0) start = 0;
-    for (int i = start; i < (int)twitch_channel_points_pending_.size(); ++i) {
-        out["events"].push_back(twitch_channel_points_pending_[i]);
-    }
-    return out;
+    std::lock_guard<ContendedMutex> lk(channel_points_mu_);
+    return twitch_channel_points_.QueueJson(twitch::RedemptionQueue::Pending, limit);
 }
 
 nlohmann::json AppState::twitch_channel_points_history_json(int limit) const {
-    std::lock_guard<std::mutex> lk(mtx_);
-    limit = std::max(1, std::min(limit, 1000));
-
-    nlohmann::json out;
-    out["ok"] = true;
-    out["count"] = (int)twitch_channel_points_history_.size();
-    out["events"] = nlohmann::json::array();
-
-    int start = (int)twitch_channel_points_history_.size() - limit;
-    if (start < 0) start = 0;
-    for (int i = start; i < (int)twitch_channel_points_history_.size(); ++i) {
-        out["events"].push_back(twitch_channel_points_history_[i]);
-    }
-    return out;
+    std::lock_guard<ContendedMutex> lk(channel_points_mu_);
+    return twitch_channel_points_.QueueJson(twitch::RedemptionQueue::History, limit);
 }
 
 bool AppState::release_twitch_channel_points_pending(
@@ -770,159 +769,102 @@ bool AppState::release_twitch_channel_points_pending(
         return false;
     }
 
-    std::lock_guard<std::mutex> lk(mtx_);
-
-    nlohmann::json item = TakeChannelPointsByRedemptionId(
-        twitch_channel_points_pending_, redemption_id);
+    std::lock_guard<ContendedMutex> lk(channel_points_mu_);
 
-    if (!item.is_object()) {
+    const auto pending = twitch_channel_points_.Take(twitch::RedemptionQueue::Pending, redemption_id);
+    if (!pending) {
         if (err) *err = "not_found";
         return false;
     }
 
-    item["queue_state"] = "live";
-    item["released_by_client"] = true;
-    item["released_ts_ms"] = now_ms();
+    auto item = std::make_shared<twitch::ChannelPointsRedemption>(*pending);
+    item->released_by_client = true;
+    item->released_ts_ms = now_ms();
 
-    UpsertChannelPointsByRedemptionId(
-        twitch_channel_points_live_,
-        item,
-        kTwitchChannelPointsQueueMax_);
-
-    nlohmann::json hist = item;
-    hist["queue_state"] = "history";
-    hist["history_ts_ms"] = now_ms();
-    UpsertChannelPointsByRedemptionId(
-        twitch_channel_points_history_,
-        hist,
-        kTwitchChannelPointsQueueMax_);
-
-    if (moved) *moved = item;
+    if (moved) *moved = twitch::TwitchChannelPointsStore::ItemJson(*item, twitch::RedemptionQueue::Live);
+    twitch_channel_points_.Upsert(twitch::RedemptionQueue::Live, item);
+    twitch_channel_points_.Upsert(twitch::RedemptionQueue::History, std::move(item), now_ms());
     return true;
 }
 
 void AppState::push_tiktok_event(const EventItem& e) {
-    nlohmann::json payload = {
-        {"platform", e.platform},
-        {"type", e.type},
-        {"user", e.user},
-        {"message", e.message},
-        {"ts_ms", e.ts_ms}
-    };
-
-    if (e.data.is_object()) {
-        for (auto it = e.data.begin(); it != e.data.end(); ++it) {
-            if (!payload.contains(it.key())) {
-                payload[it.key()] = it.value();
-            }
-        }
-    }
+    auto payload = std::make_shared<nlohmann::json>(EventItemJson(e));
 
     // Also record into unified alerts history.
-    record_alert_history_(payload);
+    record_alert_history_(*payload);
 
-    std::lock_guard<std::mutex> lk(mtx_);
-    tiktok_events_.push_back(e);
-    while (tiktok_events_.size() > 200) tiktok_events_.pop_front();
+    {
+        std::lock_guard<ContendedMutex> lk(tiktok_mu_);
+        FeedEventEntry entry;
+        entry.seq = next_event_feed_seq_();
+        (*payload)["seq"] = entry.seq;
+        entry.payload = payload;
+        tiktok_event_seq_ = entry.seq;
+        tiktok_events_.push_back(std::move(entry));
+        while (tiktok_events_.size() > 200) tiktok_events_.pop_front();
+    }
+    bump_version(Domain::TikTokEvents);
+    publish_support_event_(SupportPlatform::TikTok, std::move(payload));
 }
 
-nlohmann::json AppState::tiktok_events_json(size_t limit) const {
-    std::lock_guard<std::mutex> lk(mtx_);
+nlohmann::json AppState::tiktok_events_json(size_t limit, std::uint64_t since) const {
+    std::lock_guard<ContendedMutex> lk(tiktok_mu_);
     nlohmann::json out;
     out["count"] = (int)tiktok_events_.size();
     nlohmann::json arr = nlohmann::json::array();
 
-    size_t n = tiktok_events_.size();
-    size_t start = 0;
-    if (limit > 0 && n > limit) start = n - limit;
-
-    for (size_t i = start; i < n; ++i) {
-        const auto& e = tiktok_events_[i];
-        nlohmann::json j;
-        j["platform"] = e.platform;
-        j["type"] = e.type;
-        j["user"] = e.user;
-        j["message"] = e.message;
-        j["ts_ms"] = e.ts_ms;
-
-        if (e.data.is_object()) {
-            for (auto it = e.data.begin(); it != e.data.end(); ++it) {
-                if (!j.contains(it.key())) {
-                    j[it.key()] = it.value();
-                }
-            }
-        }
-
-        arr.push_back(std::move(j));
+    const std::size_t n = tiktok_events_.size();
+    const auto range = FeedWindow(tiktok_events_, since, limit > 0 ? limit : n);
+    for (std::size_t i = range.first; i < range.second; ++i) {
+        arr.push_back(*tiktok_events_[i].payload);
     }
 
     out["events"] = std::move(arr);
+    out["latest_seq"] = tiktok_event_seq_;
     return out;
 }
 
 void AppState::push_youtube_event(const EventItem& e) {
-    nlohmann::json payload = {
-        {"platform", e.platform},
-        {"type", e.type},
-        {"user", e.user},
-        {"message", e.message},
-        {"ts_ms", e.ts_ms}
-    };
-
-    if (e.data.is_object()) {
-        for (auto it = e.data.begin(); it != e.data.end(); ++it) {
-            if (!payload.contains(it.key())) {
-                payload[it.key()] = it.value();
-            }
-        }
-    }
+    auto payload = std::make_shared<nlohmann::json>(EventItemJson(e));
 
     // Also record into unified alerts history.
-    record_alert_history_(payload);
-    std::lock_guard<std::mutex> lk(mtx_);
-    youtube_events_.push_back(e);
-    while (youtube_events_.size() > 200) youtube_events_.pop_front();
-}
+    record_alert_history_(*payload);
 
-nlohmann::json AppState::youtube_events_json(size_t limit) const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    {
+        std::lock_guard<ContendedMutex> lk(youtube_mu_);
+        FeedEventEntry entry;
+        entry.seq = next_event_feed_seq_();
+        (*payload)["seq"] = entry.seq;
+        entry.payload = payload;
+        youtube_event_seq_ = entry.seq;
+        youtube_events_.push_back(std::move(entry));
+        while (youtube_events_.size() > 200) youtube_events_.pop_front();
+    }
+    bump_version(Domain::YouTubeEvents);
+    publish_support_event_(SupportPlatform::YouTube, std::move(payload));
+}
 
+nlohmann::json AppState::youtube_events_json(size_t limit, std::uint64_t since) const {
+    std::lock_guard<ContendedMutex> lk(youtube_mu_);
     nlohmann::json out;
     out["count"] = (int)youtube_events_.size();
     nlohmann::json arr = nlohmann::json::array();
 
-    size_t n = youtube_events_.size();
-    size_t start = 0;
-    if (limit > 0 && n > limit) start = n - limit;
-
-    for (size_t i = start; i < n; ++i) {
-        const auto& e = youtube_events_[i];
-        nlohmann::json j;
-        j["platform"] = e.platform;
-        j["type"] = e.type;
-        j["user"] = e.user;
-        j["message"] = e.message;
-        j["ts_ms"] = e.ts_ms;
-
-        if (e.data.is_object()) {
-            for (auto it = e.data.begin(); it != e.data.end(); ++it) {
-                if (!j.contains(it.key())) {
-                    j[it.key()] = it.value();
-                }
-            }
-        }
-
-        arr.push_back(std::move(j));
+    const std::size_t n = youtube_events_.size();
+    const auto range = FeedWindow(youtube_events_, since, limit > 0 ? limit : n);
+    for (std::size_t i = range.first; i < range.second; ++i) {
+        arr.push_back(*youtube_events_[i].payload);
     }
 
     out["events"] = std::move(arr);
+    out["latest_seq"] = youtube_event_seq_;
     return out;
 }
 
 void AppState::add_euroscope_tag_event(const nlohmann::json& ev) {
     if (!ev.is_object()) return;
 
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(euroscope_mu_);
 
     nlohmann::json payload = ev;
     payload["platform"] = "euroscope";
@@ -946,10 +888,11 @@ void AppState::add_euroscope_tag_event(const nlohmann::json& ev) {
 
     euroscope_tag_events_.push_back(std::move(entry));
     while (euroscope_tag_events_.size() > kEuroScopeTagEventsMax_) euroscope_tag_events_.pop_front();
+    bump_version(Domain::EuroScopeTagEvents);
 }
 
 nlohmann::json AppState::euroscope_tag_events_json(std::uint64_t since, int limit) const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(euroscope_mu_);
     limit = std::max(1, std::min(limit, 1000));
 
     nlohmann::json out;
@@ -980,13 +923,13 @@ nlohmann::json AppState::euroscope_tag_events_json(std::uint64_t since, int limi
 
 // --- Bot commands ---
 void AppState::set_bot_commands_storage_path(const std::string& path_utf8) {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(bot_cmds_mu_);
     bot_commands_path_utf8_ = path_utf8;
 }
 
 // --- Bot safety settings ---
 void AppState::set_bot_settings_storage_path(const std::string& path_utf8) {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(bot_settings_mu_);
     bot_settings_path_utf8_ = path_utf8;
 }
 
@@ -1006,7 +949,7 @@ static AppState::BotSettings ClampBotSettings(AppState::BotSettings s) {
 bool AppState::load_bot_settings_from_disk() {
     std::string path;
     {
-        std::lock_guard<std::mutex> lk(mtx_);
+        std::lock_guard<ContendedMutex> lk(bot_settings_mu_);
         path = bot_settings_path_utf8_;
     }
     if (path.empty()) return false;
@@ -1040,7 +983,7 @@ bool AppState::load_bot_settings_from_disk() {
         loaded = ClampBotSettings(std::move(loaded));
 
         {
-            std::lock_guard<std::mutex> lk(mtx_);
+            std::lock_guard<ContendedMutex> lk(bot_settings_mu_);
             bot_settings_ = std::move(loaded);
         }
         return true;
@@ -1057,7 +1000,7 @@ bool AppState::set_bot_settings(const nlohmann::json& settings_obj, std::string*
 
     BotSettings s;
     {
-        std::lock_guard<std::mutex> lk(mtx_);
+        std::lock_guard<ContendedMutex> lk(bot_settings_mu_);
         s = bot_settings_;
     }
 
@@ -1081,7 +1024,7 @@ bool AppState::set_bot_settings(const nlohmann::json& settings_obj, std::string*
 
     std::string path;
     {
-        std::lock_guard<std::mutex> lk(mtx_);
+        std::lock_guard<ContendedMutex> lk(bot_settings_mu_);
         bot_settings_ = s;
         path = bot_settings_path_utf8_;
     }
@@ -1095,7 +1038,7 @@ bool AppState::set_bot_settings(const nlohmann::json& settings_obj, std::string*
 }
 
 nlohmann::json AppState::bot_settings_json() const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(bot_settings_mu_);
     nlohmann::json j;
     j["per_user_gap_ms"] = bot_settings_.per_user_gap_ms;
     j["per_platform_gap_ms"] = bot_settings_.per_platform_gap_ms;
@@ -1105,14 +1048,14 @@ nlohmann::json AppState::bot_settings_json() const {
 }
 
 AppState::BotSettings AppState::bot_settings_snapshot() const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(bot_settings_mu_);
     return bot_settings_;
 }
 
 
 // --- Overlay header ---
 void AppState::set_overlay_header_storage_path(const std::string& path_utf8) {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(overlay_header_mu_);
     overlay_header_path_utf8_ = path_utf8;
 }
 
@@ -1128,7 +1071,7 @@ static AppState::OverlayHeader ClampOverlayHeader(AppState::OverlayHeader h) {
 bool AppState::load_overlay_header_from_disk() {
     std::string path;
     {
-        std::lock_guard<std::mutex> lk(mtx_);
+        std::lock_guard<ContendedMutex> lk(overlay_header_mu_);
         path = overlay_header_path_utf8_;
     }
     if (path.empty()) return false;
@@ -1147,9 +1090,10 @@ bool AppState::load_overlay_header_from_disk() {
         h = ClampOverlayHeader(h);
 
         {
-            std::lock_guard<std::mutex> lk(mtx_);
+            std::lock_guard<ContendedMutex> lk(overlay_header_mu_);
             overlay_header_ = h;
         }
+        bump_version(Domain::OverlayHeader);
         return true;
     } catch (...) {
         return false;
@@ -1174,10 +1118,11 @@ bool AppState::set_overlay_header(const nlohmann::json& header_obj, std::string*
 
     std::string path;
     {
-        std::lock_guard<std::mutex> lk(mtx_);
+        std::lock_guard<ContendedMutex> lk(overlay_header_mu_);
         overlay_header_ = h;
         path = overlay_header_path_utf8_;
     }
+    bump_version(Domain::OverlayHeader);
 
     // Persist best-effort if configured.
     if (!path.empty()) {
@@ -1195,7 +1140,7 @@ bool AppState::set_overlay_header(const nlohmann::json& header_obj, std::string*
 }
 
 nlohmann::json AppState::overlay_header_json() const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(overlay_header_mu_);
     return nlohmann::json{
         {"title", overlay_header_.title},
         {"subtitle", overlay_header_.subtitle}
@@ -1203,7 +1148,7 @@ nlohmann::json AppState::overlay_header_json() const {
 }
 
 AppState::OverlayHeader AppState::overlay_header_snapshot() const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(overlay_header_mu_);
     return overlay_header_;
 }
 
@@ -1259,7 +1204,7 @@ static bool AtomicWriteUtf8File(const std::string& path_utf8, const std::string&
 bool AppState::load_bot_commands_from_disk() {
     std::string path;
     {
-        std::lock_guard<std::mutex> lk(mtx_);
+        std::lock_guard<ContendedMutex> lk(bot_cmds_mu_);
         path = bot_commands_path_utf8_;
     }
     if (path.empty()) return false;
@@ -1307,7 +1252,7 @@ bool AppState::load_bot_commands_from_disk() {
         }
 
         {
-            std::lock_guard<std::mutex> lk(mtx_);
+            std::lock_guard<ContendedMutex> lk(bot_cmds_mu_);
             bot_cmds_ = std::move(loaded);
         }
         return true;
@@ -1345,7 +1290,7 @@ bool AppState::bot_upsert_command(const nlohmann::json& command_obj, std::string
 
     std::string path;
     {
-        std::lock_guard<std::mutex> lk(mtx_);
+        std::lock_guard<ContendedMutex> lk(bot_cmds_mu_);
         bot_cmds_[cmd] = bc;
         path = bot_commands_path_utf8_;
     }
@@ -1365,7 +1310,7 @@ bool AppState::bot_delete_command(const std::string& command) {
     bool removed = false;
     std::string path;
     {
-        std::lock_guard<std::mutex> lk(mtx_);
+        std::lock_guard<ContendedMutex> lk(bot_cmds_mu_);
         removed = (bot_cmds_.erase(cmd) > 0);
         path = bot_commands_path_utf8_;
     }
@@ -1380,7 +1325,7 @@ bool AppState::bot_delete_command(const std::string& command) {
 void AppState::set_bot_commands(const nlohmann::json& commands) {
     std::string path;
     {
-        std::lock_guard<std::mutex> lk(mtx_);
+        std::lock_guard<ContendedMutex> lk(bot_cmds_mu_);
         bot_cmds_.clear();
 
         if (commands.is_array()) {
@@ -1426,7 +1371,7 @@ void AppState::set_bot_commands(const nlohmann::json& commands) {
 }
 
 nlohmann::json AppState::bot_commands_json() const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(bot_cmds_mu_);
     std::vector<std::string> keys;
     keys.reserve(bot_cmds_.size());
     for (const auto& kv : bot_cmds_) keys.push_back(kv.first);
@@ -1447,7 +1392,7 @@ nlohmann::json AppState::bot_commands_json() const {
 }
 
 std::string AppState::bot_lookup_response(const std::string& command_lc) const {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(bot_cmds_mu_);
     auto it = bot_cmds_.find(command_lc);
     if (it == bot_cmds_.end()) return {};
     if (!it->second.enabled) return {};
@@ -1460,7 +1405,7 @@ std::string AppState::bot_try_get_response(
     bool is_broadcaster,
     std::int64_t now_ms)
 {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(bot_cmds_mu_);
 
     auto it = bot_cmds_.find(command_lc);
     if (it == bot_cmds_.end()) return {};
@@ -1488,7 +1433,7 @@ std::string AppState::bot_peek_response(
     bool is_broadcaster,
     std::int64_t now_ms) const
 {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(bot_cmds_mu_);
 
     auto it = bot_cmds_.find(command_lc);
     if (it == bot_cmds_.end()) return {};
@@ -1511,55 +1456,15 @@ std::string AppState::bot_peek_response(
 
 void AppState::push_log_utf8(const std::string& msg) {
     if (msg.empty()) return;
-
-    std::lock_guard<std::mutex> lk(mtx_);
-    LogEntry e;
-    e.id = ++log_next_id_;
-    e.ts_ms = now_ms();
-    e.msg = msg;
-
-    log_.push_back(std::move(e));
-    while (log_.size() > 2000) log_.pop_front(); // keep it bounded
+    log_.Append(msg, now_ms());
 }
 
 nlohmann::json AppState::log_json(std::uint64_t since, int limit) const {
-    std::lock_guard<std::mutex> lk(mtx_);
-    limit = std::max(1, std::min(limit, 1000));
-
-    nlohmann::json out;
-    out["ok"] = true;
-    nlohmann::json arr = nlohmann::json::array();
-
-    // When no cursor is supplied yet, return the most recent `limit` entries,
-    // but keep them in oldest -> newest order within that window.
-    if (since == 0) {
-        int start = static_cast<int>(log_.size()) - limit;
-        if (start < 0) start = 0;
-
-        for (int i = start; i < static_cast<int>(log_.size()); ++i) {
-            const auto& e = log_[i];
-            arr.push_back({
-                {"id", e.id},
-                {"ts_ms", e.ts_ms},
-                {"msg", e.msg}
-                });
-        }
-    } else {
-        // Incremental fetch path: return entries with id > since, oldest -> newest.
-        int count = 0;
-        for (const auto& e : log_) {
-            if (e.id <= since) continue;
-            arr.push_back({
-                {"id", e.id},
-                {"ts_ms", e.ts_ms},
-                {"msg", e.msg}
-                });
-            if (++count >= limit) break;
-        }
-    }
+    return log_.Json(since, limit);
+}
 
-    out["entries"] = std::move(arr);
-    return out;
+void AppState::set_log_capacity(std::size_t lines) {
+    log_.Reset(lines);
 }
 
 
@@ -1569,7 +1474,6 @@ void AppState::load_twitch_stream_draft_from_config_unlocked()
 {
     if (twitch_stream_draft_loaded_) return;
     twitch_stream_draft_loaded_ = true;
-
     try {
         const auto path = std::filesystem::absolute("config.json");
         std::ifstream in(path, std::ios::binary);
@@ -1610,42 +1514,18 @@ void AppState::load_twitch_stream_draft_from_config_unlocked()
 
 void AppState::save_twitch_stream_draft_to_config_unlocked()
 {
-    try {
-        const auto path = std::filesystem::absolute("config.json");
-
-        nlohmann::json j = nlohmann::json::object();
-
-        // Load existing config if present so we don't clobber secrets/other settings.
-        {
-            std::ifstream in(path, std::ios::binary);
-            if (in) {
-                std::string s((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
-                if (!s.empty()) {
-                    j = nlohmann::json::parse(s);
-                    if (!j.is_object()) j = nlohmann::json::object();
-                }
-            }
-        }
-
-        nlohmann::json t;
-        t["title"] = twitch_stream_draft_.title;
-        t["category_name"] = twitch_stream_draft_.category_name;
-        t["category_id"] = twitch_stream_draft_.category_id;
-        t["description"] = twitch_stream_draft_.description;
+    nlohmann::json t;
+    t["title"] = twitch_stream_draft_.title;
+    t["category_name"] = twitch_stream_draft_.category_name;
+    t["category_id"] = twitch_stream_draft_.category_id;
+    t["description"] = twitch_stream_draft_.description;
 
-        j["twitch_streaminfo"] = t;
-
-        // Atomic write via existing helper (expects UTF-8 path).
-        AtomicWriteUtf8File(path.u8string(), j.dump(2));
-    }
-    catch (...) {
-        // best-effort persistence; ignore failures
-    }
+    SharedConfigWriter().Set(std::filesystem::absolute("config.json"), "/twitch_streaminfo", std::move(t));
 }
 
 void AppState::set_twitch_stream_draft(const TwitchStreamDraft& d)
 {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(stream_draft_mu_);
     load_twitch_stream_draft_from_config_unlocked(); // ensure loaded once
     twitch_stream_draft_ = d;
     save_twitch_stream_draft_to_config_unlocked();
@@ -1653,14 +1533,14 @@ void AppState::set_twitch_stream_draft(const TwitchStreamDraft& d)
 
 AppState::TwitchStreamDraft AppState::twitch_stream_draft_snapshot()
 {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(stream_draft_mu_);
     load_twitch_stream_draft_from_config_unlocked();
     return twitch_stream_draft_;
 }
 
 nlohmann::json AppState::twitch_stream_draft_json()
 {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(stream_draft_mu_);
     load_twitch_stream_draft_from_config_unlocked();
     nlohmann::json j;
     j["ok"] = true;
@@ -1702,31 +1582,12 @@ void AppState::load_twitch_reward_actions_from_config_unlocked()
 
 void AppState::save_twitch_reward_actions_to_config_unlocked()
 {
-    try {
-        const auto path = std::filesystem::absolute("config.json");
-
-        nlohmann::json j = nlohmann::json::object();
-        {
-            std::ifstream in(path, std::ios::binary);
-            if (in) {
-                std::string s((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
-                if (!s.empty()) {
-                    j = nlohmann::json::parse(s);
-                    if (!j.is_object()) j = nlohmann::json::object();
-                }
-            }
-        }
-
-        j["twitch_reward_actions"] = twitch_reward_actions_;
-        AtomicWriteUtf8File(path.u8string(), j.dump(2));
-    }
-    catch (...) {
-    }
+    SharedConfigWriter().Set(std::filesystem::absolute("config.json"), "/twitch_reward_actions", twitch_reward_actions_);
 }
 
 nlohmann::json AppState::twitch_reward_actions_json()
 {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(channel_points_mu_);
     load_twitch_reward_actions_from_config_unlocked();
     nlohmann::json out = nlohmann::json::object();
     out["ok"] = true;
@@ -1736,7 +1597,7 @@ nlohmann::json AppState::twitch_reward_actions_json()
 
 nlohmann::json AppState::twitch_reward_action_json(const std::string& reward_id)
 {
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(channel_points_mu_);
     load_twitch_reward_actions_from_config_unlocked();
     nlohmann::json out = nlohmann::json::object();
     out["ok"] = true;
@@ -1757,7 +1618,7 @@ bool AppState::set_twitch_reward_action(const std::string& reward_id, const nloh
         return false;
     }
 
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(channel_points_mu_);
     load_twitch_reward_actions_from_config_unlocked();
     twitch_reward_actions_[reward_id] = action_obj;
     save_twitch_reward_actions_to_config_unlocked();
@@ -1767,7 +1628,7 @@ bool AppState::set_twitch_reward_action(const std::string& reward_id, const nloh
 bool AppState::delete_twitch_reward_action(const std::string& reward_id)
 {
     if (reward_id.empty()) return false;
-    std::lock_guard<std::mutex> lk(mtx_);
+    std::lock_guard<ContendedMutex> lk(channel_points_mu_);
     load_twitch_reward_actions_from_config_unlocked();
     if (!twitch_reward_actions_.is_object()) twitch_reward_actions_ = nlohmann::json::object();
     const auto erased = twitch_reward_actions_.erase(reward_id);
@@ -1,4 +1,6 @@
 #pragma once
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <mutex>
 #include <deque>
@@ -7,13 +9,25 @@
 #include <chrono>
 #include <vector>
 #include <unordered_map>
+#include <functional>
+#include <utility>
 #include "json.hpp"
+#include "alerts/AlertHistoryStore.h"
+#include "core/ContendedMutex.h"
+#include "core/SeqLock.h"
+#include "core/SupportEventBus.h"
+#include "log/LogRing.h"
+#include "twitch/TwitchChannelPointsStore.h"
 
 struct ChatMessage {
     std::string platform;
     std::string user;
     std::string message;
 
+    // Source channel/room when the adapter knows it (Twitch: channel login without '#').
+    // Bot replies target it; not serialized.
+    std::string channel;
+
     // Optional rich message representation (e.g. YouTube "runs" containing emoji thumbnails).
     // When present, overlays can render emojis as images while retaining `message` as a plain-text fallback.
     nlohmann::json runs; // null or array
@@ -87,9 +101,16 @@ class AppState {
 public:
     void push_log_utf8(const std::string& msg);
     nlohmann::json log_json(std::uint64_t since = 0, int limit = 200) const;
+    // Lines kept for /api/log (rounded up to a power of two). Startup only: call before the
+    // state is handed to UiLog.
+    void set_log_capacity(std::size_t lines);
 
     std::vector<ChatMessage> recent_chat() const;
 
+    // Hydrates the persisted follower/subscriber counts from config.json (key: metrics_cache).
+    // Call once at startup, after the working directory is set and before the pollers start.
+    void load_metrics_cache_from_config();
+
     void set_tiktok_viewers(int v);
     void set_tiktok_followers(int f);
     void set_twitch_viewers(int v);
@@ -102,10 +123,15 @@ public:
     void set_tiktok_live(bool live);
     void push_tiktok_event(const EventItem& e);
 
+    // Lock-free: readers copy the last published snapshot (see metrics_snapshot_).
     Metrics get_metrics() const;
     nlohmann::json metrics_json() const;
     nlohmann::json chat_json() const;
-    nlohmann::json tiktok_events_json(size_t limit = 200) const;
+    // Event feeds (TikTok, YouTube, Twitch EventSub) share one global sequence, so every event
+    // carries a "seq" and responses include "latest_seq". With since == 0 the newest `limit`
+    // events; otherwise up to `limit` events with seq > since, oldest first. Pass the last seq
+    // seen (or latest_seq when nothing came back) as the next `since`.
+    nlohmann::json tiktok_events_json(size_t limit = 200, std::uint64_t since = 0) const;
 
     // --- Homepage runtime state (requested start/stop actions from the control surface) ---
     void set_platform_runtime_state(const std::string& platform, const std::string& requested_state);
@@ -118,7 +144,7 @@ public:
     void add_twitch_eventsub_event(const nlohmann::json& ev);
     void request_twitch_subscriber_refresh();
     bool consume_twitch_subscriber_refresh_requested();
-    nlohmann::json twitch_eventsub_events_json(int limit = 200) const;
+    nlohmann::json twitch_eventsub_events_json(int limit = 200, std::uint64_t since = 0) const;
     void clear_twitch_eventsub_events();
 
     // Ring buffer of recent EventSub errors/warnings (for quick diagnosis).
@@ -126,22 +152,56 @@ public:
     nlohmann::json twitch_eventsub_errors_json(int limit = 50) const;
 
     void push_youtube_event(const EventItem& e);
-    nlohmann::json youtube_events_json(size_t limit = 200) const;
+    nlohmann::json youtube_events_json(size_t limit = 200, std::uint64_t since = 0) const;
 
     // --- EuroScope transient controller instruction events ---
     void add_euroscope_tag_event(const nlohmann::json& ev);
     nlohmann::json euroscope_tag_events_json(std::uint64_t since = 0, int limit = 200) const;
 
     // --- Unified alerts history (across Twitch/TikTok/YouTube) ---
-    // Returns a rolling in-memory history for "missed alerts" tooling.
-    // Optional platform filter: "twitch" | "tiktok" | "youtube"
-    nlohmann::json alerts_history_json(int limit = 200, const std::string& platform = "") const;
+    // History for "missed alerts" tooling, kept in memory and (once opened) in an append-only log
+    // under `dir_utf8` so it survives restarts. Call before any alert is recorded.
+    bool open_alerts_history_log(const std::string& dir_utf8, std::size_t* loaded = nullptr, std::string* err = nullptr);
+
+    // Serialized page, newest first. Optional platform filter: "twitch" | "tiktok" | "youtube".
+    // `before` / `after` are history ids (numeric part of "hist-N"); see AlertHistoryStore::PageJson.
+    std::string alerts_history_json(int limit = 200, const std::string& platform = "",
+                                    std::uint64_t before = 0, std::uint64_t after = 0) const;
 
     // Re-inject a stored history item back into the live platform queues (with a fresh id/ts)
     // so overlays/chat can replay missed alerts.
     // Returns true on success; on failure, `err` (if provided) is filled.
     bool resend_alert_history(const std::string& history_id, nlohmann::json* replayed = nullptr, std::string* err = nullptr);
 
+    // --- Support event bus (Fenix failure automation, /api/stream push) ---
+    // Every EventSub/TikTok/YouTube event is delivered once to each subscriber, on the producing
+    // thread, after it is in the alerts history and its feed. See SupportEventBus for the rules.
+    std::uint64_t subscribe_support_events(std::string name, SupportEventBus::Handler handler);
+    void unsubscribe_support_events(std::uint64_t id);
+    nlohmann::json support_event_subscribers_json() const;
+
+    // --- Change versions (HTTP response cache / ETag) ---
+    // Each domain's counter is bumped after every change to the data it covers, so a response
+    // built for version N can be served again until the counter moves.
+    enum class Domain : std::size_t {
+        Metrics,
+        PlatformStatus,
+        OverlayHeader,
+        TwitchEventSub,
+        TikTokEvents,
+        YouTubeEvents,
+        AlertsHistory,
+        EuroScopeTagEvents,
+        Count
+    };
+    std::uint64_t version(Domain d) const;
+    // For domain data that is also persisted outside AppState (e.g. overlay header route fields).
+    void bump_version(Domain d);
+
+    // --- Lock diagnostics ---
+    // Per lock domain: acquisitions, how many found the lock held, and total wait time.
+    nlohmann::json lock_stats_json() const;
+
     // --- Bot commands (chatbot) ---
     // Storage path should be set once at startup (utf-8 path). If empty, commands are in-memory only.
     void set_bot_commands_storage_path(const std::string& path_utf8);
@@ -257,67 +317,106 @@ private:
     void upsert_twitch_channel_points_pending_unlocked(const nlohmann::json& ev);
     bool remove_twitch_channel_points_pending_unlocked(const std::string& redemption_id, nlohmann::json* removed = nullptr);
 
-    void load_metrics_cache_from_config_unlocked();
-    void save_metrics_cache_to_config_unlocked();
+    // Queues the persisted counts on SharedConfigWriter(); called after metrics_mu_ is released.
+    void save_metrics_cache_to_config(const Metrics& m);
 
     static std::int64_t now_ms();
 
-    struct AlertHistoryItem {
-        std::string history_id;   // stable id for history lookup (not the original platform id)
-        nlohmann::json payload;   // original payload (normalized to include platform/type/user/message/ts_ms where possible)
-        std::string platform;     // cached for filtering
-        std::int64_t ts_ms{};     // cached for sorting/display
-    };
-
     struct EuroScopeTagEventEntry {
         std::uint64_t seq{};
         std::int64_t ts_ms{};
         nlohmann::json payload;
     };
 
+    // One event-feed entry (EventSub, TikTok, YouTube). The payload is built once at push time
+    // and shared by feed polls and the support-event bus.
+    struct FeedEventEntry {
+        std::uint64_t seq{};
+        std::shared_ptr<const nlohmann::json> payload; // includes "seq"
+    };
+
+    // Next number from the shared event-feed sequence. Called under the feed's own lock, so
+    // each feed's deque stays sorted by seq.
+    std::uint64_t next_event_feed_seq_() { return event_feed_seq_.fetch_add(1, std::memory_order_relaxed) + 1; }
+
     void record_alert_history_(const nlohmann::json& payload);
+    void publish_support_event_(SupportPlatform platform, std::shared_ptr<const nlohmann::json> payload);
+
+    // State is split into independently locked domains so the chat/bot path, HTTP pollers and
+    // LogLine() from every thread do not serialize behind one mutex. Each mutex guards only the
+    // members listed under it. Lock order: at most one domain lock at a time. config.json writes
+    // are queued on SharedConfigWriter(), which never calls back into AppState.
 
-    static std::string make_alert_history_id_(std::uint64_t seq);
+    SupportEventBus support_events_; // internally synchronized
 
-    static constexpr std::size_t kAlertsHistoryMax_ = 5000;
-    mutable std::mutex alerts_history_mu_;
-    std::deque<AlertHistoryItem> alerts_history_;
-    std::uint64_t alerts_history_seq_ = 0;
+    std::array<std::atomic<std::uint64_t>, (std::size_t)Domain::Count> versions_{};
 
+    mutable ContendedMutex alerts_history_mu_;
+    alerts::AlertHistoryStore alerts_history_;
 
-    mutable std::mutex mtx_;
-    // Twitch stream info draft (loaded lazily from config.json)
+    // --- Twitch stream info draft (loaded lazily from config.json) ---
+    mutable ContendedMutex stream_draft_mu_;
     bool twitch_stream_draft_loaded_ = false;
     TwitchStreamDraft twitch_stream_draft_{};
 
-    // Twitch reward action metadata (loaded lazily from config.json)
+    // --- Channel points: reward action metadata (lazy from config.json) + runtime queues ---
+    mutable ContendedMutex channel_points_mu_;
     bool twitch_reward_actions_loaded_ = false;
     nlohmann::json twitch_reward_actions_ = nlohmann::json::object();
-
-    std::deque<nlohmann::json> twitch_channel_points_live_;
-    std::deque<nlohmann::json> twitch_channel_points_pending_;
-    std::deque<nlohmann::json> twitch_channel_points_history_;
     static constexpr std::size_t kTwitchChannelPointsQueueMax_ = 500;
+    twitch::TwitchChannelPointsStore twitch_channel_points_{ kTwitchChannelPointsQueueMax_ };
 
-    // Metrics cache (loaded lazily from config.json under key: metrics_cache)
-    bool metrics_cache_loaded_ = false;
-    std::int64_t last_metrics_cache_save_ms_ = 0;
-    bool twitch_subscriber_refresh_requested_ = false;
-
+    // --- Metrics ---
+    // Writers (Helix/TikTok/YouTube pollers) serialize on metrics_mu_, update metrics_ and publish
+    // it with one SeqLock store; get_metrics() never takes the lock.
+    mutable ContendedMutex metrics_mu_;
     Metrics metrics_{};
+    SeqLock<Metrics> metrics_snapshot_;
+
+    // --- Homepage runtime state ---
+    mutable ContendedMutex platform_mu_;
     nlohmann::json platform_runtime_state_ = nlohmann::json{
         {"tiktok", {{"requested_state", "stopped"}, {"ts_ms", 0}}},
         {"twitch", {{"requested_state", "stopped"}, {"ts_ms", 0}}},
         {"youtube", {{"requested_state", "stopped"}, {"ts_ms", 0}}}
     };
+
+    mutable ContendedMutex chat_mu_;
     std::deque<ChatMessage> chat_; // last 200
-    std::deque<EventItem> tiktok_events_; // last 200
-    std::deque<EventItem> youtube_events_; // last 200
+
+    std::atomic<std::uint64_t> event_feed_seq_{ 0 }; // last seq handed to any event feed
+
+    mutable ContendedMutex tiktok_mu_;
+    std::deque<FeedEventEntry> tiktok_events_; // last 200, ascending seq
+    std::uint64_t tiktok_event_seq_ = 0;  // seq of the newest TikTok event
+
+    mutable ContendedMutex youtube_mu_;
+    std::deque<FeedEventEntry> youtube_events_; // last 200, ascending seq
+    std::uint64_t youtube_event_seq_ = 0;
+
+    mutable ContendedMutex euroscope_mu_;
     std::deque<EuroScopeTagEventEntry> euroscope_tag_events_; // last 500
     std::uint64_t euroscope_tag_event_seq_ = 0;
     static constexpr std::size_t kEuroScopeTagEventsMax_ = 500;
-    std::deque<nlohmann::json> twitch_eventsub_events_; // last 200 by default
+
+    // --- Twitch EventSub status + events/errors kept small for UI/debugging ---
+    mutable ContendedMutex eventsub_mu_;
+    std::deque<FeedEventEntry> twitch_eventsub_events_; // last 200, ascending seq
+    std::uint64_t twitch_eventsub_event_seq_ = 0;
     std::deque<ErrorEntry> twitch_eventsub_errors_; // last 200 (most recent)
+    std::uint64_t twitch_eventsub_error_next_id_ = 0;
+    nlohmann::json twitch_eventsub_status_ = nlohmann::json{
+        {"ws_state", "stopped"},
+        {"connected", false},
+        {"session_id", ""},
+        {"subscribed", false},
+        {"last_ws_message_ms", 0},
+        {"last_keepalive_ms", 0},
+        {"last_helix_ok_ms", 0},
+        {"last_error", ""},
+        {"subscriptions", nlohmann::json::array()}
+    };
+    std::atomic<bool> twitch_subscriber_refresh_requested_{ false };
 
     // --- Bot commands ---
     struct BotCmd {
@@ -328,38 +427,22 @@ private:
         std::int64_t last_fire_ms = 0;
     };
 
+    mutable ContendedMutex bot_cmds_mu_;
     std::unordered_map<std::string, BotCmd> bot_cmds_; // key is lowercase command (no '!')
     std::string bot_commands_path_utf8_;
+
     // --- Bot safety settings ---
+    mutable ContendedMutex bot_settings_mu_;
     BotSettings bot_settings_{};
     std::string bot_settings_path_utf8_;
 
+    // --- Overlay header ---
+    mutable ContendedMutex overlay_header_mu_;
+    OverlayHeader overlay_header_{};
+    std::string overlay_header_path_utf8_;
 
-// --- Overlay header ---
-OverlayHeader overlay_header_{};
-std::string overlay_header_path_utf8_;
-
-    // EventSub status + events kept small for UI/debugging.
-    nlohmann::json twitch_eventsub_status_ = nlohmann::json{
-        {"ws_state", "stopped"},
-        {"connected", false},
-        {"session_id", ""},
-        {"subscribed", false},
-        {"last_ws_message_ms", 0},
-        {"last_keepalive_ms", 0},
-        {"last_helix_ok_ms", 0},
-        {"last_error", ""},
-        {"subscriptions", nlohmann::json::array()}
-    };    
-
-
-
-    struct LogEntry {
-        std::uint64_t id{};
-        std::int64_t ts_ms{};
-        std::string msg;
-    };
-
-    std::deque<LogEntry> log_;          // ring buffer
-    std::uint64_t log_next_id_ = 0;     // monotonically increasing
+    // --- Log ring ---
+    // Appended from every thread without a shared lock (see LogRing).
+    static constexpr std::size_t kDefaultLogCapacity_ = 4096;
+    LogRing log_{ kDefaultLogCapacity_ };
 };
\ No newline at end of file
@@ -0,0 +1,269 @@
+#include "alerts/AlertHistoryStore.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace alerts {
+
+namespace {
+
+constexpr std::size_t kMaxSegments = AlertHistoryStore::kMemoryMax / AlertHistoryStore::kSegmentEntries + 2;
+constexpr std::uint64_t kMaxGapFill = 1024; // larger holes in the log restart the window
+
+const char kSegmentPrefix[] = "alerts-";
+const char kSegmentSuffix[] = ".jsonl";
+
+bool IsSegmentName(const std::string& name) {
+    const std::size_t p = sizeof(kSegmentPrefix) - 1;
+    const std::size_t s = sizeof(kSegmentSuffix) - 1;
+    return name.size() > p + s &&
+        name.compare(0, p, kSegmentPrefix) == 0 &&
+        name.compare(name.size() - s, s, kSegmentSuffix) == 0;
+}
+
+// Sorted oldest first (names are zero-padded first seqs).
+std::vector<std::filesystem::path> ListSegments(const std::filesystem::path& dir) {
+    std::vector<std::filesystem::path> out;
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file(ec) && IsSegmentName(it->path().filename().u8string())) {
+            out.push_back(it->path());
+        }
+    }
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+std::string Dump(const nlohmann::json& j) {
+    return j.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+} // namespace
+
+AlertHistoryStore::~AlertHistoryStore() {
+    if (segment_.is_open()) segment_.close();
+}
+
+std::string AlertHistoryStore::HistoryId(std::uint64_t seq) {
+    return std::string("hist-") + std::to_string(seq);
+}
+
+std::uint64_t AlertHistoryStore::ParseHistoryId(const std::string& id) {
+    std::size_t i = (id.compare(0, 5, "hist-") == 0) ? 5 : 0;
+    if (i >= id.size()) return 0;
+    std::uint64_t v = 0;
+    for (; i < id.size(); ++i) {
+        const char c = id[i];
+        if (c < '0' || c > '9') return 0;
+        v = v * 10 + (std::uint64_t)(c - '0');
+    }
+    return v;
+}
+
+bool AlertHistoryStore::Open(const std::filesystem::path& dir, std::size_t* loaded, std::string* err) {
+    if (loaded) *loaded = 0;
+    if (!entries_.empty() || segment_.is_open()) {
+        if (err) *err = "already_in_use";
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    if (!std::filesystem::is_directory(dir, ec)) {
+        if (err) *err = "cannot_create_dir";
+        return false;
+    }
+    dir_ = dir;
+
+    auto segments = ListSegments(dir_);
+    while (segments.size() > kMaxSegments) {
+        std::filesystem::remove(segments.front(), ec);
+        segments.erase(segments.begin());
+    }
+
+    bool last_line_complete = true;
+    std::size_t last_segment_lines = 0;
+    for (const auto& path : segments) {
+        std::ifstream in(path, std::ios::binary);
+        std::string line;
+        std::size_t lines = 0;
+        last_line_complete = true;
+        while (std::getline(in, line)) {
+            ++lines;
+            last_line_complete = !in.eof();
+            if (line.empty()) continue;
+
+            nlohmann::json j;
+            try { j = nlohmann::json::parse(line); }
+            catch (...) { continue; } // torn write
+
+            const std::uint64_t seq = j.is_object() ? j.value("history_seq", (std::uint64_t)0) : 0;
+            if (seq < next_seq_) continue;
+
+            if (seq > next_seq_ && !entries_.empty()) {
+                if (seq - next_seq_ > kMaxGapFill) {
+                    entries_.clear();
+                    by_platform_.clear();
+                }
+                else {
+                    while (next_seq_ < seq) Push(Entry{ next_seq_, {}, {} });
+                }
+            }
+
+            Entry e;
+            e.seq = seq;
+            e.platform = j.value("platform", "");
+            e.json = std::move(line);
+            next_seq_ = seq;
+            Push(std::move(e));
+        }
+        last_segment_lines = lines;
+    }
+
+    if (loaded) *loaded = entries_.size();
+
+    // Keep filling the newest segment until it is full.
+    if (!segments.empty() && last_segment_lines < kSegmentEntries) {
+        segment_.open(segments.back(), std::ios::binary | std::ios::app);
+        segment_entries_ = last_segment_lines;
+        if (segment_ && !last_line_complete) segment_ << '\n';
+    }
+    return true;
+}
+
+void AlertHistoryStore::Push(Entry e) {
+    if (!e.json.empty()) by_platform_[e.platform].push_back(e.seq);
+    next_seq_ = e.seq + 1;
+    entries_.push_back(std::move(e));
+
+    while (entries_.size() > kMemoryMax) {
+        const Entry& old = entries_.front();
+        if (!old.json.empty()) {
+            auto it = by_platform_.find(old.platform);
+            if (it != by_platform_.end() && !it->second.empty() && it->second.front() == old.seq) {
+                it->second.pop_front();
+                if (it->second.empty()) by_platform_.erase(it);
+            }
+        }
+        entries_.pop_front();
+    }
+}
+
+std::uint64_t AlertHistoryStore::Append(nlohmann::json payload, const std::string& platform) {
+    const std::uint64_t seq = next_seq_;
+    payload["history_id"] = HistoryId(seq);
+    payload["history_seq"] = seq;
+
+    Entry e;
+    e.seq = seq;
+    e.platform = platform;
+    e.json = Dump(payload);
+    AppendToLog(e.json);
+    Push(std::move(e));
+    return seq;
+}
+
+void AlertHistoryStore::AppendToLog(const std::string& line) {
+    if (dir_.empty()) return;
+
+    if (!segment_.is_open() || segment_entries_ >= kSegmentEntries) {
+        OpenSegment(next_seq_);
+        if (!segment_.is_open()) return;
+    }
+
+    // Flushed per alert so a crash loses at most the line being written.
+    segment_.write(line.data(), (std::streamsize)line.size());
+    segment_.put('\n');
+    segment_.flush();
+    ++segment_entries_;
+}
+
+void AlertHistoryStore::OpenSegment(std::uint64_t first_seq) {
+    if (segment_.is_open()) segment_.close();
+    segment_.clear();
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s%012llu%s", kSegmentPrefix, (unsigned long long)first_seq, kSegmentSuffix);
+    segment_.open(dir_ / name, std::ios::binary | std::ios::app);
+    segment_entries_ = 0;
+    PruneSegments();
+}
+
+void AlertHistoryStore::PruneSegments() {
+    auto segments = ListSegments(dir_);
+    std::error_code ec;
+    for (std::size_t i = 0; i + kMaxSegments < segments.size(); ++i) {
+        std::filesystem::remove(segments[i], ec);
+    }
+}
+
+const AlertHistoryStore::Entry* AlertHistoryStore::At(std::uint64_t seq) const {
+    if (entries_.empty()) return nullptr;
+    const std::uint64_t first = entries_.front().seq;
+    if (seq < first || seq - first >= entries_.size()) return nullptr;
+    const Entry& e = entries_[(std::size_t)(seq - first)];
+    return e.json.empty() ? nullptr : &e;
+}
+
+bool AlertHistoryStore::Find(std::uint64_t seq, nlohmann::json* payload) const {
+    const Entry* e = At(seq);
+    if (!e) return false;
+    if (payload) {
+        try { *payload = nlohmann::json::parse(e->json); }
+        catch (...) { return false; }
+    }
+    return true;
+}
+
+std::string AlertHistoryStore::PageJson(int limit, const std::string& platform, std::uint64_t before, std::uint64_t after) const {
+    const std::size_t lim = (std::size_t)std::max(1, std::min((int)kPageMax, limit));
+
+    // Candidate ids, oldest first: every seq in the window, or one platform's list.
+    static const std::deque<std::uint64_t> kNone;
+    const std::deque<std::uint64_t>* ids = nullptr;
+    if (!platform.empty()) {
+        auto it = by_platform_.find(platform);
+        ids = (it != by_platform_.end()) ? &it->second : &kNone;
+    }
+    const std::uint64_t first = entries_.empty() ? 0 : entries_.front().seq;
+    const std::size_t n = ids ? ids->size() : entries_.size();
+    auto seq_at = [&](std::size_t pos) { return ids ? (*ids)[pos] : first + pos; };
+    auto lower = [&](std::uint64_t seq) -> std::size_t { // first position with seq_at >= seq
+        if (ids) return (std::size_t)(std::lower_bound(ids->begin(), ids->end(), seq) - ids->begin());
+        if (seq <= first) return 0;
+        return (std::size_t)std::min<std::uint64_t>(seq - first, n);
+    };
+
+    // Position range [lo, hi) to emit.
+    std::size_t lo = 0;
+    std::size_t hi = 0;
+    if (after > 0) {
+        lo = lower(after + 1);
+        hi = std::min(n, lo + lim);
+    }
+    else {
+        hi = before > 0 ? lower(before) : n;
+        lo = hi > lim ? hi - lim : 0;
+    }
+
+    std::string out;
+    out.reserve(64 + (hi - lo) * 256);
+    out += "{\"ok\":true,\"events\":[";
+    std::size_t count = 0;
+    for (std::size_t pos = hi; pos > lo; --pos) {
+        const Entry* e = At(seq_at(pos - 1));
+        if (!e) continue;
+        if (count++) out += ',';
+        out += e->json;
+    }
+    out += "],\"count\":" + std::to_string(count);
+    out += ",\"latest_seq\":" + std::to_string(latest_seq());
+    out += ",\"oldest_seq\":" + std::to_string(n ? seq_at(0) : 0);
+    out += ",\"next_before\":" + ((lo > 0 && hi > lo) ? std::to_string(seq_at(lo)) : std::string("null"));
+    out += ",\"has_more\":" + std::string((after > 0 ? hi < n : lo > 0) ? "true" : "false");
+    out += "}";
+    return out;
+}
+
+} // namespace alerts
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+#include "json.hpp"
+
+namespace alerts {
+
+// Unified alerts history ("missed alerts"), in memory plus an append-only log on disk.
+//
+// Entries get consecutive numeric ids (exposed as "hist-<seq>"), so a lookup is an index into
+// the in-memory window rather than a scan. Each entry's payload is serialized once on append;
+// pages are assembled from those strings. A per-platform list of ids serves filtered pages
+// without walking other platforms' alerts.
+//
+// The log is a directory of JSON-lines segments (alerts-<first seq>.jsonl, kSegmentEntries
+// lines each). Open() reloads the retained tail, so history and ids survive a restart or crash;
+// a torn last line is skipped. Segments no longer covered by the in-memory window are deleted.
+//
+// Not thread-safe; AppState guards it with alerts_history_mu_.
+class AlertHistoryStore {
+public:
+    static constexpr std::size_t kMemoryMax = 50000;
+    static constexpr std::size_t kSegmentEntries = 4096;
+    static constexpr std::size_t kPageMax = 5000;
+
+    AlertHistoryStore() = default;
+    ~AlertHistoryStore();
+
+    AlertHistoryStore(const AlertHistoryStore&) = delete;
+    AlertHistoryStore& operator=(const AlertHistoryStore&) = delete;
+
+    // Loads the log in `dir` (created if missing) and appends new entries to it. Must be called
+    // before the first Append(); without it the history is memory-only.
+    bool Open(const std::filesystem::path& dir, std::size_t* loaded = nullptr, std::string* err = nullptr);
+
+    // Stores a normalized payload (history_id / history_seq are added) and returns its seq.
+    std::uint64_t Append(nlohmann::json payload, const std::string& platform);
+
+    // Payload of entry `seq` (as served, including history_id). False if unknown or evicted.
+    bool Find(std::uint64_t seq, nlohmann::json* payload) const;
+
+    // Serialized page, newest first:
+    //   {"ok","count","events","latest_seq","oldest_seq","next_before","has_more"}
+    // `before` returns entries older than that id, `after` the oldest `limit` entries newer
+    // than it (for catching up); with neither, the newest `limit` entries.
+    std::string PageJson(int limit, const std::string& platform, std::uint64_t before, std::uint64_t after) const;
+
+    std::uint64_t latest_seq() const { return next_seq_ - 1; }
+    std::size_t size() const { return entries_.size(); }
+
+    static std::string HistoryId(std::uint64_t seq);
+    // Accepts "hist-123" or "123"; 0 when not an id.
+    static std::uint64_t ParseHistoryId(const std::string& id);
+
+private:
+    struct Entry {
+        std::uint64_t seq = 0;
+        std::string platform;
+        std::string json; // empty: placeholder for a line lost from the log
+    };
+
+    void Push(Entry e);
+    void AppendToLog(const std::string& line);
+    void OpenSegment(std::uint64_t first_seq);
+    void PruneSegments();
+    const Entry* At(std::uint64_t seq) const;
+
+    std::deque<Entry> entries_;  // consecutive seqs: entries_[i].seq == entries_.front().seq + i
+    std::unordered_map<std::string, std::deque<std::uint64_t>> by_platform_;
+    std::uint64_t next_seq_ = 1;
+
+    std::filesystem::path dir_;
+    std::ofstream segment_;
+    std::size_t segment_entries_ = 0;
+};
+
+} // namespace alerts
@@ -3,6 +3,7 @@
 #include <windows.h>
 #include "app/AppBootstrap.h"
 
+#include <algorithm>
 #include <filesystem>
 #include <fstream>
 
@@ -12,6 +13,7 @@
 #include "chat/ChatAggregator.h"
 #include "core/StringUtil.h"
 #include "euroscope/EuroScopeIngestService.h"
+#include "euroscope/EuroScopeBinaryListener.h"
 #include "http/HttpServer.h"
 #include "http/HttpServerOptionsBuilder.h"
 #include "log/UiLog.h"
@@ -54,10 +56,30 @@ void InitializeUiAndState(
 {
     (void)deps.config.Load();
 
+    // Sized before UiLog starts feeding it (the ring is not resizable once shared). Wired up
+    // before the storage loaders below so their log lines reach the web log too.
+    deps.state.set_log_capacity((std::size_t)std::clamp(deps.config.log_capacity, 1000, 1 << 20));
+    UiLog_SetWebLogState(&deps.state);
+
+    // Persisted follower/subscriber counts, so the first metrics reads are not zero.
+    deps.state.load_metrics_cache_from_config();
+
     bot::InitializeBotStorage(deps.state, GetExeDir());
     overlay::InitializeOverlayHeaderStorage(deps.state, GetExeDir());
 
-    UiLog_SetWebLogState(&deps.state);
+    // Missed-alerts history survives restarts via an append-only log next to the exe.
+    {
+        const std::filesystem::path dir = std::filesystem::path(GetExeDir()) / "alerts_history";
+        std::size_t loaded = 0;
+        std::string err;
+        if (deps.state.open_alerts_history_log(ToUtf8(dir.wstring()), &loaded, &err)) {
+            LogLine(L"ALERTS: loaded " + std::to_wstring(loaded) + L" history entries from alerts_history");
+        }
+        else {
+            LogLine(L"ALERTS: history log unavailable (" + ToW(err) + L") - keeping history in memory only");
+        }
+    }
+
     deps.youtubeChat.SetReplyAuth(&deps.youtubeAuth);
     bot::SubscribeBotCommandHandler(
         deps.chat,
@@ -144,6 +166,11 @@ void StartBackend(
         [](const std::wstring& s) { LogLine(s); });
     httpServer->Start();
 
+    // High-rate EuroScope traffic stream (msgpack/CBOR frames); POST /api/euroscope stays available.
+    deps.euroscopeBinary.Start(
+        euroscope,
+        [](const std::wstring& s) { LogLine(s); });
+
     WebViewHost::SetHttpReadyAndNavigate(modernUiUrl);
 
     runtime::StartObsMetricsPublisher(
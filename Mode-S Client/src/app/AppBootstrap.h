@@ -25,6 +25,7 @@ class YouTubeAuth;
 class YouTubeLiveChatService;
 class HttpServer;
 class EuroScopeIngestService;
+class EuroScopeBinaryListener;
 class ObsWsClient;
 namespace fenixsim { class FenixSimFailuresClient; class FenixFailureCoordinator; }
 
@@ -47,6 +48,7 @@ struct Dependencies {
     std::thread& twitchHelixThread;
     std::thread& tiktokFollowersThread;
     EuroScopeIngestService& euroscope;
+    EuroScopeBinaryListener& euroscopeBinary;
     ObsWsClient& obs;
     fenixsim::FenixSimFailuresClient& fenixFailures;
     fenixsim::FenixFailureCoordinator& fenixFailureCoordinator;
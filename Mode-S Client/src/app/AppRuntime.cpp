@@ -22,6 +22,7 @@ AppBootstrap::Dependencies AppRuntime::BuildBootstrapDeps(HWND hwnd)
         twitchHelixThread,
         tiktokFollowersThread,
         euroscope,
+        euroscopeBinary,
         obs,
         fenixFailures,
         fenixFailureCoordinator,
@@ -38,11 +39,13 @@ AppShutdown::Dependencies AppRuntime::BuildShutdownDeps()
         metricsThread,
         twitchHelixThread,
         tiktokFollowersThread,
+        chat,
         twitchEventSub,
         twitchAuth,
         twitch,
         youtubeChat,
         tiktok,
+        euroscopeBinary,
         fenixFailureCoordinator,
         running,
         twitchHelixRunning
@@ -20,6 +20,7 @@ typedef struct HWND__* HWND;
 #include "youtube/YouTubeAuth.h"
 #include "youtube/YouTubeLiveChatService.h"
 #include "euroscope/EuroScopeIngestService.h"
+#include "euroscope/EuroScopeBinaryListener.h"
 #include "obs/ObsWsClient.h"
 #include "fenixsim/FenixSimFailures.h"
 #include "fenixsim/FenixFailureCoordinator.h"
@@ -40,6 +41,7 @@ struct AppRuntime {
     std::thread twitchHelixThread;
     std::thread tiktokFollowersThread;
     EuroScopeIngestService euroscope;
+    EuroScopeBinaryListener euroscopeBinary;
     ObsWsClient obs;
     fenixsim::FenixSimFailuresClient fenixFailures;
     fenixsim::FenixFailureCoordinator fenixFailureCoordinator;
@@ -5,6 +5,9 @@
 
 #include "app/AppShutdown.h"
 
+#include "bot/BotCommandDispatcher.h"
+#include "core/ConfigWriteBehind.h"
+#include "chat/ChatAggregator.h"
 #include "twitch/TwitchEventSubWsClient.h"
 #include "twitch/TwitchAuth.h"
 #include "twitch/TwitchIrcWsClient.h"
@@ -15,6 +18,7 @@
 #include "platform/PlatformControl.h"
 #include "runtime/YouTubeRuntimeCoordinator.h"
 #include "fenixsim/FenixFailureCoordinator.h"
+#include "euroscope/EuroScopeBinaryListener.h"
 
 namespace AppShutdown {
 
@@ -38,6 +42,11 @@ void BeginShutdown(Dependencies& deps, HWND hwndToDestroy)
         LogLine(L"SHUTDOWN: HTTP stopped");
     }
 
+    LogLine(L"SHUTDOWN: stopping EuroScope binary ingest...");
+    try { deps.euroscopeBinary.Stop(); }
+    catch (...) {}
+    LogLine(L"SHUTDOWN: stopped EuroScope binary ingest");
+
     // 3) Join threads next
     if (deps.tiktokFollowersThread.joinable()) {
         LogLine(L"SHUTDOWN: join tiktokFollowersThread...");
@@ -57,6 +66,17 @@ void BeginShutdown(Dependencies& deps, HWND hwndToDestroy)
         LogLine(L"SHUTDOWN: joined metricsThread");
     }
 
+    // 3b) Stop chat subscriber threads (bot replies) before the services they send through
+    LogLine(L"SHUTDOWN: stopping chat subscribers...");
+    try { deps.chat.StopSubscribers(); }
+    catch (...) {}
+    LogLine(L"SHUTDOWN: stopped chat subscribers");
+
+    // 3c) Stop the bot reply senders before the platform clients they call into
+    try { bot::StopBotReplyQueue(); }
+    catch (...) {}
+    LogLine(L"SHUTDOWN: stopped bot reply queue");
+
     // 4) Stop services last
     LogLine(L"SHUTDOWN: stopping services...");
 
@@ -101,6 +121,11 @@ void BeginShutdown(Dependencies& deps, HWND hwndToDestroy)
 
     LogLine(L"SHUTDOWN: services stopped");
 
+    // 4b) Write out pending config.json patches (tokens, metrics cache) after the services that submit them
+    try { SharedConfigWriter().Stop(); }
+    catch (...) {}
+    LogLine(L"SHUTDOWN: flushed config writer");
+
     // 5) Destroy window to reach WM_DESTROY -> PostQuitMessage
     if (hwndToDestroy && IsWindow(hwndToDestroy)) {
         LogLine(L"SHUTDOWN: destroying window");
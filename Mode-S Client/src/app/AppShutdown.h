@@ -15,6 +15,7 @@ class TwitchEventSubWsClient;
 class TwitchAuth;
 class YouTubeLiveChatService;
 class HttpServer;
+class EuroScopeBinaryListener;
 namespace fenixsim { class FenixFailureCoordinator; }
 
 namespace AppShutdown {
@@ -26,11 +27,13 @@ struct Dependencies {
     std::thread& twitchHelixThread;
     std::thread& tiktokFollowersThread;
 
+    ChatAggregator& chat;
     TwitchEventSubWsClient& twitchEventSub;
     TwitchAuth& twitchAuth;
     TwitchIrcWsClient& twitch;
     YouTubeLiveChatService& youtubeChat;
     TikTokSidecar& tiktok;
+    EuroScopeBinaryListener& euroscopeBinary;
     fenixsim::FenixFailureCoordinator& fenixFailureCoordinator;
 
     std::atomic<bool>& running;
@@ -3,11 +3,12 @@
 #include <algorithm>
 #include <cctype>
 #include <chrono>
-#include <mutex>
 #include <string>
-#include <unordered_map>
 
 #include "AppState.h"
+#include "bot/BotCooldownTable.h"
+#include "bot/BotReplyQueue.h"
+#include "bot/BotReplyRouter.h"
 #include "chat/ChatAggregator.h"
 #include "core/StringUtil.h"
 #include "log/UiLog.h"
@@ -25,6 +26,65 @@ std::string ToLowerAscii(std::string s)
     return s;
 }
 
+// Outbound reply pipeline shared by all platforms (senders registered in SubscribeBotCommandHandler).
+BotReplyRouter& ReplyRouter()
+{
+    static BotReplyRouter router;
+    return router;
+}
+
+BotReplyQueue& ReplyQueue()
+{
+    static BotReplyQueue queue(ReplyRouter());
+    return queue;
+}
+
+// Cooldown stamps for per_user_gap_ms / per_platform_gap_ms. Bounded: long streams with many
+// chatters recycle the oldest entries instead of growing.
+BotCooldownTable& UserCooldowns()
+{
+    static BotCooldownTable table(4096);
+    return table;
+}
+
+BotCooldownTable& PlatformCooldowns()
+{
+    static BotCooldownTable table(64);
+    return table;
+}
+
+void RegisterReplySenders(
+    TwitchIrcWsClient& twitch,
+    TikTokSidecar& tiktok,
+    YouTubeLiveChatService& youtubeChat)
+{
+    auto& router = ReplyRouter();
+    router.SetLogger([](const std::string& msg) { LogLine(ToW(msg)); });
+
+    router.Register("twitch", [pTwitch = &twitch](const BotReplyTarget& target, const std::string& text) {
+        const bool ok = target.channel_id.empty()
+            ? pTwitch->SendPrivMsg(text)
+            : pTwitch->SendPrivMsgTo(target.channel_id, text);
+        if (ok) return BotSendResult::Sent;
+        LogLine(L"BOT: Twitch send failed");
+        return BotSendResult::Failed;
+    });
+    router.Register("tiktok", [pTikTok = &tiktok](const BotReplyTarget&, const std::string& text) {
+        if (pTikTok->send_chat(text)) return BotSendResult::Sent;
+        LogLine(L"BOT: TikTok send failed (sidecar)");
+        return BotSendResult::Failed;
+    });
+    router.Register("youtube", [pYouTubeChat = &youtubeChat](const BotReplyTarget&, const std::string& text) {
+        std::string err;
+        bool uncertain = false;
+        if (pYouTubeChat->send_chat(text, &err, &uncertain)) return BotSendResult::Sent;
+        LogLine(ToW(std::string("BOT: YouTube send failed: ") + err));
+        return uncertain ? BotSendResult::Uncertain : BotSendResult::Failed;
+    });
+
+    ReplyQueue().SetLogger([](const std::string& msg) { LogLine(ToW(msg)); });
+}
+
 } // namespace
 
 namespace bot {
@@ -40,12 +100,19 @@ void SubscribeBotCommandHandler(
     if (botSubscribed) return;
     botSubscribed = true;
 
+    RegisterReplySenders(twitch, tiktok, youtubeChat);
+
+    // Runs on the bot's own dispatch thread, so slow sends (YouTube HTTP, METAR) never block
+    // the platform thread that delivered the message. If the bot falls behind, the oldest
+    // pending commands are dropped rather than replied to late.
+    ChatAggregator::SubscribeOptions opts;
+    opts.name = "bot";
+    opts.queue_capacity = 256;
+    opts.overflow = ChatAggregator::OverflowPolicy::DropOldest;
+
     chat.Subscribe([
         pChat = &chat,
-        pState = &state,
-        pTwitch = &twitch,
-        pTikTok = &tiktok,
-        pYouTubeChat = &youtubeChat
+        pState = &state
     ](const ChatMessage& m) {
         if (m.user == "StreamingATC.Bot") return;
         if (m.message.size() < 2 || m.message[0] != '!') return;
@@ -67,75 +134,61 @@ void SubscribeBotCommandHandler(
             return;
         }
 
-        static std::mutex rl_mu;
-        static std::unordered_map<std::string, long long> last_by_user;
-        static std::unordered_map<std::string, long long> last_by_platform;
-
         const long long kUserGapMs = static_cast<long long>(bot_settings.per_user_gap_ms);
         const long long kPlatformGapMs = static_cast<long long>(bot_settings.per_platform_gap_ms);
 
         std::string platform_lc = ToLowerAscii(m.platform);
         std::string user_key = platform_lc + "|" + m.user;
 
-        {
-            std::lock_guard<std::mutex> lk(rl_mu);
-            if (kPlatformGapMs > 0) {
-                auto itp = last_by_platform.find(platform_lc);
-                if (itp != last_by_platform.end() && (now_ms_ll - itp->second) < kPlatformGapMs) {
-                    return;
-                }
-            }
-            if (kUserGapMs > 0) {
-                auto itu = last_by_user.find(user_key);
-                if (itu != last_by_user.end() && (now_ms_ll - itu->second) < kUserGapMs) {
-                    return;
-                }
-            }
-            last_by_platform[platform_lc] = now_ms_ll;
-            last_by_user[user_key] = now_ms_ll;
+        if (!PlatformCooldowns().Ready(platform_lc, now_ms_ll, kPlatformGapMs)) {
+            return;
         }
+        if (!UserCooldowns().Ready(user_key, now_ms_ll, kUserGapMs)) {
+            return;
+        }
+        if (kPlatformGapMs > 0) PlatformCooldowns().Stamp(platform_lc, now_ms_ll, kPlatformGapMs);
+        if (kUserGapMs > 0) UserCooldowns().Stamp(user_key, now_ms_ll, kUserGapMs);
 
-        auto send_reply = [&](std::string reply) {
-            const size_t kMaxReplyLen = bot_settings.max_reply_len;
-            if (kMaxReplyLen > 0 && reply.size() > kMaxReplyLen) {
-                reply.resize(kMaxReplyLen);
-            }
-            if (kMaxReplyLen == 0) {
-                return;
-            }
+        const size_t kMaxReplyLen = bot_settings.max_reply_len;
+        if (kMaxReplyLen == 0) {
+            return;
+        }
 
+        // Replies go through the outbound queue: the platform sender thread does the network
+        // work (and retries), so this handler never waits on a send.
+        BotOutboundMessage out;
+        out.target.platform_lc = platform_lc;
+        out.target.channel_id = m.channel;
+        out.priority = m.is_mod || m.is_broadcaster;
+        out.on_ready = [pChat, platform = m.platform, ts = now_ms_ll + 1](const std::string& reply) {
             ChatMessage bot{};
-            bot.platform = m.platform;
+            bot.platform = platform;
             bot.user = "StreamingATC.Bot";
             bot.message = reply;
-            bot.ts_ms = static_cast<uint64_t>(now_ms_ll + 1);
+            bot.ts_ms = static_cast<uint64_t>(ts);
             pChat->Add(std::move(bot));
+        };
 
-            if (platform_lc == "twitch" && pTwitch) {
-                if (!pTwitch->SendPrivMsg(reply)) {
-                    LogLine(L"BOT: Twitch send failed");
-                }
-            }
-            if (platform_lc == "tiktok" && pTikTok) {
-                if (!pTikTok->send_chat(reply)) {
-                    LogLine(L"BOT: TikTok send failed (sidecar)");
-                }
-            }
-            if (platform_lc == "youtube" && pYouTubeChat) {
-                std::string err;
-                if (!pYouTubeChat->send_chat(reply, &err)) {
-                    LogLine(ToW(std::string("BOT: YouTube send failed: ") + err));
-                }
+        auto clamp_reply = [kMaxReplyLen](std::string reply) {
+            if (reply.size() > kMaxReplyLen) {
+                reply.resize(kMaxReplyLen);
             }
+            return reply;
         };
 
-        std::string metarReply;
-        std::string metarLogError;
-        if (metar::TryGetMetarReply(m.message, metarReply, &metarLogError)) {
-            if (!metarLogError.empty()) {
-                LogLine(ToW(std::string("BOT: METAR lookup note: ") + metarLogError));
-            }
-            send_reply(std::move(metarReply));
+        if (metar::IsMetarCommand(m.message)) {
+            // METAR needs a network lookup; defer it to the sender thread.
+            out.coalesce_key = "metar|" + ToLowerAscii(m.message);
+            out.produce = [message = m.message, clamp_reply]() {
+                std::string metarReply;
+                std::string metarLogError;
+                metar::TryGetMetarReply(message, metarReply, &metarLogError);
+                if (!metarLogError.empty()) {
+                    LogLine(ToW(std::string("BOT: METAR lookup note: ") + metarLogError));
+                }
+                return clamp_reply(std::move(metarReply));
+            };
+            ReplyQueue().Enqueue(std::move(out));
             return;
         }
 
@@ -149,8 +202,24 @@ void SubscribeBotCommandHandler(
         std::string reply = template_reply;
         ReplaceAll(reply, "{user}", m.user);
         ReplaceAll(reply, "{platform}", platform_lc);
-        send_reply(std::move(reply));
-    });
+        out.text = clamp_reply(std::move(reply));
+        ReplyQueue().Enqueue(std::move(out));
+    }, opts);
+}
+
+void StopBotReplyQueue()
+{
+    ReplyQueue().Stop();
+}
+
+nlohmann::json BotReplyQueueMetricsJson()
+{
+    nlohmann::json j = ReplyQueue().MetricsJson();
+    j["cooldowns"] = {
+        {"user", UserCooldowns().MetricsJson()},
+        {"platform", PlatformCooldowns().MetricsJson()}
+    };
+    return j;
 }
 
 } // namespace bot
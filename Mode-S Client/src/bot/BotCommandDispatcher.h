@@ -1,5 +1,7 @@
 #pragma once
 
+#include "json.hpp"
+
 class AppState;
 class ChatAggregator;
 class TikTokSidecar;
@@ -15,4 +17,11 @@ void SubscribeBotCommandHandler(
     TikTokSidecar& tiktok,
     YouTubeLiveChatService& youtubeChat);
 
+// Stops the per-platform reply sender threads (call during shutdown, before the platform clients stop).
+void StopBotReplyQueue();
+
+// Outbound reply queue depth, send/failure counters and latency per platform, plus the
+// size/eviction counters of the cooldown tables.
+nlohmann::json BotReplyQueueMetricsJson();
+
 } // namespace bot
@@ -0,0 +1,80 @@
+#include "bot/BotCooldownTable.h"
+
+#include <algorithm>
+#include <functional>
+
+BotCooldownTable::BotCooldownTable(std::size_t capacity)
+    : capacity_per_shard_(std::max<std::size_t>(1, (capacity + kShards - 1) / kShards)) {}
+
+BotCooldownTable::Shard& BotCooldownTable::ShardFor(const std::string& key)
+{
+    return shards_[std::hash<std::string>{}(key) % kShards];
+}
+
+void BotCooldownTable::ExpireLocked(Shard& s, std::int64_t now_ms, std::int64_t ttl_ms)
+{
+    // The list is ordered by stamp time, so expired entries are all at the back.
+    while (!s.lru.empty() && now_ms - s.lru.back().second >= ttl_ms) {
+        s.index.erase(s.lru.back().first);
+        s.lru.pop_back();
+        evicted_expired_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool BotCooldownTable::Ready(const std::string& key, std::int64_t now_ms, std::int64_t gap_ms)
+{
+    if (gap_ms <= 0) return true;
+
+    Shard& s = ShardFor(key);
+    std::lock_guard<std::mutex> lock(s.mu);
+    auto it = s.index.find(key);
+    if (it == s.index.end() || now_ms - it->second->second >= gap_ms) return true;
+
+    throttled_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void BotCooldownTable::Stamp(const std::string& key, std::int64_t now_ms, std::int64_t ttl_ms)
+{
+    Shard& s = ShardFor(key);
+    std::lock_guard<std::mutex> lock(s.mu);
+    ExpireLocked(s, now_ms, std::max<std::int64_t>(0, ttl_ms));
+
+    auto it = s.index.find(key);
+    if (it != s.index.end()) {
+        it->second->second = now_ms;
+        s.lru.splice(s.lru.begin(), s.lru, it->second);
+    }
+    else {
+        if (s.lru.size() >= capacity_per_shard_) {
+            s.index.erase(s.lru.back().first);
+            s.lru.pop_back();
+            evicted_capacity_.fetch_add(1, std::memory_order_relaxed);
+        }
+        s.lru.emplace_front(key, now_ms);
+        s.index.emplace(key, s.lru.begin());
+    }
+    stamped_.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::size_t BotCooldownTable::Size() const
+{
+    std::size_t n = 0;
+    for (const auto& s : shards_) {
+        std::lock_guard<std::mutex> lock(s.mu);
+        n += s.lru.size();
+    }
+    return n;
+}
+
+nlohmann::json BotCooldownTable::MetricsJson() const
+{
+    return nlohmann::json{
+        {"size", Size()},
+        {"capacity", capacity_per_shard_ * kShards},
+        {"stamped", stamped_.load(std::memory_order_relaxed)},
+        {"throttled", throttled_.load(std::memory_order_relaxed)},
+        {"evicted_expired", evicted_expired_.load(std::memory_order_relaxed)},
+        {"evicted_capacity", evicted_capacity_.load(std::memory_order_relaxed)}
+    };
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "json.hpp"
+
+// Fixed-memory "last seen" table for the chatbot's per-user / per-platform cooldowns.
+//
+// Keys are spread over kShards independently locked shards. Each shard is an LRU list with a
+// hard entry cap; entries whose cooldown has passed are evicted as the shard is touched, and
+// when a shard is full its least recently used key is dropped. A dropped key just loses its
+// cooldown early, which is the right trade for a throttle table.
+class BotCooldownTable {
+public:
+    static constexpr std::size_t kShards = 16;
+
+    explicit BotCooldownTable(std::size_t capacity);
+
+    BotCooldownTable(const BotCooldownTable&) = delete;
+    BotCooldownTable& operator=(const BotCooldownTable&) = delete;
+
+    // True when `key` has no stamp within the last `gap_ms` (always true for gap_ms <= 0).
+    bool Ready(const std::string& key, std::int64_t now_ms, std::int64_t gap_ms);
+
+    // Stamps `key` at now_ms. Entries older than `ttl_ms` are evicted on the way.
+    void Stamp(const std::string& key, std::int64_t now_ms, std::int64_t ttl_ms);
+
+    std::size_t Size() const;
+
+    // {size, capacity, stamped, throttled, evicted_expired, evicted_capacity}
+    nlohmann::json MetricsJson() const;
+
+private:
+    struct Shard {
+        mutable std::mutex mu;
+        std::list<std::pair<std::string, std::int64_t>> lru; // front = most recently stamped
+        std::unordered_map<std::string, std::list<std::pair<std::string, std::int64_t>>::iterator> index;
+    };
+
+    Shard& ShardFor(const std::string& key);
+    void ExpireLocked(Shard& s, std::int64_t now_ms, std::int64_t ttl_ms);
+
+    std::size_t capacity_per_shard_;
+    std::array<Shard, kShards> shards_;
+
+    std::atomic<std::uint64_t> stamped_{ 0 };
+    std::atomic<std::uint64_t> throttled_{ 0 };
+    std::atomic<std::uint64_t> evicted_expired_{ 0 };
+    std::atomic<std::uint64_t> evicted_capacity_{ 0 };
+};
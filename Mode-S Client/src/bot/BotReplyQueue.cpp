@@ -0,0 +1,386 @@
+#include "bot/BotReplyQueue.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+std::int64_t SteadyMsSince(std::chrono::steady_clock::time_point t)
+{
+    return (std::int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - t).count();
+}
+
+std::int64_t UnixNowMs()
+{
+    return (std::int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+std::int64_t SteadyNowMs()
+{
+    return (std::int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const std::string& CoalesceKey(const BotOutboundMessage& m)
+{
+    return m.coalesce_key.empty() ? m.text : m.coalesce_key;
+}
+
+nlohmann::json LimitJson(BotSendWindow& w, std::int64_t now_ms)
+{
+    return nlohmann::json{
+        {"limit", w.Limit()},
+        {"window_ms", w.WindowMs()},
+        {"used", w.Used(now_ms)}
+    };
+}
+
+} // namespace
+
+BotSendWindow::BotSendWindow(int limit, std::int64_t window_ms)
+    : limit_(std::max(0, limit)), window_ms_(std::max<std::int64_t>(0, window_ms)) {}
+
+void BotSendWindow::Expire(std::int64_t now_ms)
+{
+    while (!sends_.empty() && now_ms - sends_.front() >= window_ms_) sends_.pop_front();
+}
+
+std::int64_t BotSendWindow::WaitMs(std::int64_t now_ms)
+{
+    if (limit_ <= 0) return 0;
+    Expire(now_ms);
+    if ((int)sends_.size() < limit_) return 0;
+    return std::max<std::int64_t>(1, sends_.front() + window_ms_ - now_ms);
+}
+
+void BotSendWindow::Take(std::int64_t now_ms)
+{
+    if (limit_ <= 0) return;
+    sends_.push_back(now_ms);
+}
+
+int BotSendWindow::Used(std::int64_t now_ms)
+{
+    Expire(now_ms);
+    return (int)sends_.size();
+}
+
+BotReplyQueue::BotReplyQueue(BotReplyRouter& router)
+    : BotReplyQueue(router, Options{}) {}
+
+BotReplyQueue::BotReplyQueue(BotReplyRouter& router, Options opts)
+    : router_(router), opts_(opts)
+{
+    if (opts_.max_queue_per_platform == 0) opts_.max_queue_per_platform = 1;
+    if (opts_.max_attempts < 1) opts_.max_attempts = 1;
+}
+
+BotReplyQueue::~BotReplyQueue()
+{
+    Stop();
+}
+
+void BotReplyQueue::SetLogger(LogFn fn)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    logger_ = std::move(fn);
+}
+
+void BotReplyQueue::Log(const std::string& msg) const
+{
+    LogFn fn;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        fn = logger_;
+    }
+    if (fn) fn(msg);
+}
+
+BotReplyQueue::Lane* BotReplyQueue::GetOrCreateLaneLocked(const std::string& platform, const std::string& channel)
+{
+    const std::string key = channel.empty() ? platform : (platform + "#" + channel);
+    auto it = lanes_.find(key);
+    if (it != lanes_.end()) return it->second.get();
+
+    auto& pw = platform_windows_[platform];
+    if (!pw) {
+        pw = std::make_unique<PlatformWindow>();
+        auto lim = opts_.platform_limits.find(platform);
+        if (lim != opts_.platform_limits.end()) pw->window = BotSendWindow(lim->second.limit, lim->second.window_ms);
+    }
+
+    auto lane = std::make_unique<Lane>();
+    lane->key = key;
+    lane->platform = platform;
+    lane->platform_window = pw.get();
+    auto lim = opts_.channel_limits.find(platform);
+    if (lim != opts_.channel_limits.end()) lane->channel_window = BotSendWindow(lim->second.limit, lim->second.window_ms);
+    Lane* raw = lane.get();
+    lanes_.emplace(key, std::move(lane));
+    raw->thread = std::thread([this, raw]() { RunLane(raw); });
+    return raw;
+}
+
+bool BotReplyQueue::Enqueue(BotOutboundMessage msg)
+{
+    if (stopped_.load()) return false;
+
+    const std::string key = router_.Resolve(msg.target.platform_lc);
+
+    Lane* lane = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (stopped_.load()) return false;
+        lane = GetOrCreateLaneLocked(key, msg.target.channel_id);
+    }
+
+    bool dropped = false;
+    {
+        std::lock_guard<std::mutex> lk(lane->mu);
+        ++lane->enqueued;
+
+        // Raids and repeated commands produce the same reply many times over; send it once.
+        const std::string& ckey = CoalesceKey(msg);
+        if (!ckey.empty()) {
+            auto same = [&](const Item& it) { return CoalesceKey(it.msg) == ckey; };
+            auto hp = std::find_if(lane->priority_queue.begin(), lane->priority_queue.end(), same);
+            if (hp != lane->priority_queue.end()) {
+                ++lane->coalesced;
+                return true;
+            }
+            auto np = std::find_if(lane->queue.begin(), lane->queue.end(), same);
+            if (np != lane->queue.end()) {
+                ++lane->coalesced;
+                if (msg.priority) {
+                    np->msg.priority = true;
+                    lane->priority_queue.push_back(std::move(*np));
+                    lane->queue.erase(np);
+                }
+                return true;
+            }
+        }
+
+        if (lane->Depth() >= opts_.max_queue_per_platform) {
+            // A reply that waited this long is stale; prefer the newest commands.
+            if (!lane->queue.empty()) lane->queue.pop_front();
+            else lane->priority_queue.pop_front();
+            ++lane->dropped;
+            dropped = true;
+        }
+        auto& q = msg.priority ? lane->priority_queue : lane->queue;
+        q.push_back(Item{ std::move(msg), std::chrono::steady_clock::now() });
+    }
+    lane->cv.notify_one();
+
+    if (dropped) {
+        Log("BotReplyQueue: '" + lane->key + "' queue full, dropped oldest pending reply");
+    }
+    return true;
+}
+
+bool BotReplyQueue::SleepUnlessStopped(Lane* lane, std::int64_t ms)
+{
+    std::unique_lock<std::mutex> lk(lane->mu);
+    lane->cv.wait_for(lk, std::chrono::milliseconds(ms), [this]() { return stopped_.load(); });
+    return !stopped_.load();
+}
+
+bool BotReplyQueue::AcquireSendSlot(Lane* lane)
+{
+    bool throttled = false;
+    std::unique_lock<std::mutex> lk(lane->mu);
+    for (;;) {
+        if (stopped_.load()) return false;
+
+        const std::int64_t now = SteadyNowMs();
+        std::int64_t wait_ms = lane->channel_window.WaitMs(now);
+        {
+            std::lock_guard<std::mutex> pl(lane->platform_window->mu);
+            wait_ms = std::max(wait_ms, lane->platform_window->window.WaitMs(now));
+            if (wait_ms == 0) {
+                lane->platform_window->window.Take(now);
+                lane->channel_window.Take(now);
+                return true;
+            }
+        }
+
+        if (!throttled) {
+            throttled = true;
+            ++lane->throttled;
+        }
+        lane->cv.wait_for(lk, std::chrono::milliseconds(wait_ms), [this]() { return stopped_.load(); });
+    }
+}
+
+void BotReplyQueue::RunLane(Lane* lane)
+{
+    for (;;) {
+        Item item;
+        {
+            std::unique_lock<std::mutex> lk(lane->mu);
+            lane->cv.wait(lk, [&]() { return stopped_.load() || lane->Depth() > 0; });
+            if (stopped_.load()) return;
+            auto& q = !lane->priority_queue.empty() ? lane->priority_queue : lane->queue;
+            item = std::move(q.front());
+            q.pop_front();
+        }
+
+        std::string text = std::move(item.msg.text);
+        if (item.msg.produce) {
+            try { text = item.msg.produce(); }
+            catch (...) { text.clear(); }
+        }
+        if (text.empty()) {
+            std::lock_guard<std::mutex> lk(lane->mu);
+            ++lane->skipped;
+            continue;
+        }
+
+        if (item.msg.on_ready) {
+            try { item.msg.on_ready(text); }
+            catch (...) {}
+        }
+
+        if (!router_.HasSender(lane->platform)) {
+            bool first = false;
+            {
+                std::lock_guard<std::mutex> lk(lane->mu);
+                first = lane->unsent++ == 0;
+            }
+            if (first) Log("BotReplyQueue: no sender registered for platform '" + lane->platform + "'; replies are echoed only");
+            continue;
+        }
+
+        // Only now take a send token: a reply that produced no text or has no sender must not
+        // use up the channel's budget.
+        if (!AcquireSendSlot(lane)) return;
+        {
+            std::lock_guard<std::mutex> lk(lane->mu);
+            const std::int64_t wait_ms = SteadyMsSince(item.enqueued);
+            ++lane->waited;
+            lane->last_wait_ms = wait_ms;
+            lane->max_wait_ms = std::max(lane->max_wait_ms, wait_ms);
+            lane->total_wait_ms += wait_ms;
+        }
+
+        BotSendResult result = BotSendResult::Failed;
+        std::int64_t backoff_ms = opts_.retry_backoff_ms;
+        for (int attempt = 1; attempt <= opts_.max_attempts; ++attempt) {
+            try { result = router_.Send(item.msg.target, text); }
+            catch (...) { result = BotSendResult::Failed; }
+            // An uncertain send may already be in chat; a retry could post it twice.
+            if (result != BotSendResult::Failed) break;
+
+            if (attempt < opts_.max_attempts) {
+                {
+                    std::lock_guard<std::mutex> lk(lane->mu);
+                    ++lane->retried;
+                }
+                if (!SleepUnlessStopped(lane, backoff_ms)) return;
+                if (!AcquireSendSlot(lane)) return;
+                backoff_ms *= 2;
+            }
+        }
+
+        const bool ok = result == BotSendResult::Sent;
+        const std::int64_t latency_ms = SteadyMsSince(item.enqueued);
+        {
+            std::lock_guard<std::mutex> lk(lane->mu);
+            if (ok) {
+                ++lane->sent;
+                lane->last_latency_ms = latency_ms;
+                lane->max_latency_ms = std::max(lane->max_latency_ms, latency_ms);
+                lane->total_latency_ms += latency_ms;
+                lane->last_sent_ms = UnixNowMs();
+            }
+            else if (result == BotSendResult::Uncertain) {
+                ++lane->uncertain;
+            }
+            else {
+                ++lane->failed;
+            }
+        }
+
+        if (result == BotSendResult::Uncertain) {
+            Log("BotReplyQueue: '" + lane->key + "' send outcome unknown; not retried to avoid a duplicate");
+        }
+        else if (!ok) {
+            Log("BotReplyQueue: '" + lane->key + "' send failed after " +
+                std::to_string(opts_.max_attempts) + " attempt(s)");
+        }
+    }
+}
+
+void BotReplyQueue::Stop()
+{
+    std::vector<Lane*> lanes;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (stopped_.exchange(true)) return;
+        for (auto& kv : lanes_) lanes.push_back(kv.second.get());
+    }
+
+    for (Lane* lane : lanes) {
+        {
+            // Take the lane lock so a worker between its predicate check and wait sees the flag.
+            std::lock_guard<std::mutex> lk(lane->mu);
+            lane->priority_queue.clear();
+            lane->queue.clear();
+        }
+        lane->cv.notify_all();
+    }
+    for (Lane* lane : lanes) {
+        if (!lane->thread.joinable()) continue;
+        if (std::this_thread::get_id() == lane->thread.get_id()) lane->thread.detach();
+        else lane->thread.join();
+    }
+}
+
+nlohmann::json BotReplyQueue::MetricsJson() const
+{
+    nlohmann::json platforms = nlohmann::json::object();
+    nlohmann::json limits = nlohmann::json::object();
+    const std::int64_t now = SteadyNowMs();
+
+    std::lock_guard<std::mutex> lock(mu_);
+    for (const auto& kv : platform_windows_) {
+        std::lock_guard<std::mutex> pl(kv.second->mu);
+        limits[kv.first] = LimitJson(kv.second->window, now);
+    }
+    for (const auto& kv : lanes_) {
+        Lane& lane = *kv.second;
+        std::lock_guard<std::mutex> lk(lane.mu);
+        platforms[kv.first] = {
+            {"queued", lane.Depth()},
+            {"queued_priority", lane.priority_queue.size()},
+            {"enqueued", lane.enqueued},
+            {"sent", lane.sent},
+            {"failed", lane.failed},
+            {"uncertain", lane.uncertain},
+            {"unsent", lane.unsent},
+            {"retried", lane.retried},
+            {"dropped", lane.dropped},
+            {"skipped", lane.skipped},
+            {"coalesced", lane.coalesced},
+            {"throttled", lane.throttled},
+            {"channel_limit", LimitJson(lane.channel_window, now)},
+            {"last_wait_ms", lane.last_wait_ms},
+            {"avg_wait_ms", lane.waited ? (lane.total_wait_ms / (std::int64_t)lane.waited) : 0},
+            {"max_wait_ms", lane.max_wait_ms},
+            {"last_latency_ms", lane.last_latency_ms},
+            {"avg_latency_ms", lane.sent ? (lane.total_latency_ms / (std::int64_t)lane.sent) : 0},
+            {"max_latency_ms", lane.max_latency_ms},
+            {"last_sent_ms", lane.last_sent_ms}
+        };
+    }
+
+    return nlohmann::json{
+        {"running", !stopped_.load()},
+        {"max_queue_per_platform", opts_.max_queue_per_platform},
+        {"max_attempts", opts_.max_attempts},
+        {"platform_limits", std::move(limits)},
+        {"platforms", std::move(platforms)}
+    };
+}
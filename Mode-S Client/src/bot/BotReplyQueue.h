@@ -0,0 +1,179 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "json.hpp"
+#include "bot/BotReplyRouter.h"
+
+// One outbound bot message.
+struct BotOutboundMessage {
+    BotReplyTarget target;
+
+    // Ready-to-send text. Leave empty and set `produce` when building the text is slow
+    // (e.g. a METAR network lookup); it then runs on the platform's sender thread.
+    std::string text;
+    std::function<std::string()> produce;
+
+    // Optional: called once with the final text, before the first send attempt and also when
+    // the reply cannot be sent (used to echo the reply into the chat overlay).
+    std::function<void(const std::string&)> on_ready;
+
+    // Mod/broadcaster-triggered replies are sent ahead of normal ones.
+    bool priority = false;
+
+    // Pending messages with the same key are merged into one send. Defaults to `text`;
+    // set it for `produce` messages (e.g. the normalized command line).
+    std::string coalesce_key;
+};
+
+// Send budget of `limit` messages per rolling `window_ms`. Each send takes a token that only
+// comes back once that send is `window_ms` old, so no window ever holds more than `limit`
+// sends (a plain refill-rate bucket would let a full burst plus the refill through).
+class BotSendWindow {
+public:
+    BotSendWindow() = default;
+    BotSendWindow(int limit, std::int64_t window_ms);
+
+    // 0 when a token is available at `now_ms`, otherwise how long until one frees up.
+    std::int64_t WaitMs(std::int64_t now_ms);
+    void Take(std::int64_t now_ms);
+
+    int Limit() const { return limit_; }
+    std::int64_t WindowMs() const { return window_ms_; }
+    int Used(std::int64_t now_ms);
+
+private:
+    void Expire(std::int64_t now_ms);
+
+    int limit_ = 0; // 0 = unlimited
+    std::int64_t window_ms_ = 0;
+    std::deque<std::int64_t> sends_;
+};
+
+// Outbound pipeline for bot replies: one bounded queue + sender thread per platform/channel,
+// send windows matching each platform's chat limits, retry with backoff, and latency/failure
+// counters. Only sends that certainly did not reach the platform are retried. Senders are resolved through BotReplyRouter, so adding a platform only needs a
+// Register() call (and optionally a limit entry).
+class BotReplyQueue {
+public:
+    struct RateLimit {
+        int limit = 0;              // messages per window (0 = unlimited)
+        std::int64_t window_ms = 0;
+    };
+
+    struct Options {
+        std::size_t max_queue_per_platform = 100; // oldest pending reply is dropped beyond this
+        int max_attempts = 3;                     // including the first try
+        std::int64_t retry_backoff_ms = 750;      // doubled after each failed attempt
+
+        // Account-wide limit per platform, shared by every channel of that platform.
+        // Twitch: 20 messages / 30 s for a non-mod account. YouTube: liveChatMessages.insert
+        // has no published burst limit and costs quota, so stay conservative.
+        std::map<std::string, RateLimit> platform_limits = {
+            {"twitch", {20, 30000}},
+            {"youtube", {20, 60000}},
+            {"tiktok", {10, 30000}},
+        };
+
+        // Per-channel limit. Twitch allows a non-mod one message per second per channel.
+        std::map<std::string, RateLimit> channel_limits = {
+            {"twitch", {1, 1000}},
+            {"youtube", {1, 1500}},
+            {"tiktok", {1, 2000}},
+        };
+    };
+
+    using LogFn = std::function<void(const std::string&)>;
+
+    explicit BotReplyQueue(BotReplyRouter& router);
+    BotReplyQueue(BotReplyRouter& router, Options opts);
+    ~BotReplyQueue();
+
+    BotReplyQueue(const BotReplyQueue&) = delete;
+    BotReplyQueue& operator=(const BotReplyQueue&) = delete;
+
+    void SetLogger(LogFn fn);
+
+    // Queues a reply for its platform/channel. Never blocks on the network.
+    // Returns false when stopped. Without a registered sender the reply is still built and
+    // echoed (on_ready), just not sent.
+    // A reply identical to one still pending is merged into it (and counted as coalesced).
+    bool Enqueue(BotOutboundMessage msg);
+
+    // Stops all sender threads; pending replies are discarded. Enqueue() fails afterwards.
+    void Stop();
+
+    // Per-platform/channel queue depth, wait times and counters.
+    nlohmann::json MetricsJson() const;
+
+private:
+    struct Item {
+        BotOutboundMessage msg;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    // Account-wide window for one platform (shared by its lanes).
+    struct PlatformWindow {
+        std::mutex mu;
+        BotSendWindow window;
+    };
+
+    struct Lane {
+        std::string key;      // platform, or platform#channel
+        std::string platform; // resolved sender key
+        std::mutex mu;
+        std::condition_variable cv;
+        std::deque<Item> priority_queue;
+        std::deque<Item> queue;
+        std::thread thread;
+        PlatformWindow* platform_window = nullptr;
+        BotSendWindow channel_window; // guarded by mu
+
+        // Counters (guarded by mu).
+        std::uint64_t enqueued = 0;
+        std::uint64_t sent = 0;
+        std::uint64_t failed = 0;
+        std::uint64_t uncertain = 0; // gave up without retrying: may have been delivered
+        std::uint64_t unsent = 0;    // no sender registered for the platform
+        std::uint64_t retried = 0;
+        std::uint64_t dropped = 0;
+        std::uint64_t skipped = 0; // produce() returned empty text
+        std::uint64_t coalesced = 0;
+        std::uint64_t throttled = 0; // times a send had to wait for the rate limit
+        std::int64_t last_latency_ms = 0;
+        std::int64_t max_latency_ms = 0;
+        std::int64_t total_latency_ms = 0;
+        std::int64_t last_wait_ms = 0; // enqueue -> send slot granted
+        std::int64_t max_wait_ms = 0;
+        std::int64_t total_wait_ms = 0;
+        std::uint64_t waited = 0;
+        std::int64_t last_sent_ms = 0;
+
+        std::size_t Depth() const { return priority_queue.size() + queue.size(); }
+    };
+
+    Lane* GetOrCreateLaneLocked(const std::string& platform, const std::string& channel);
+    void RunLane(Lane* lane);
+    bool SleepUnlessStopped(Lane* lane, std::int64_t ms);
+    // Blocks until both rate windows have a token and takes it; false once stopped.
+    bool AcquireSendSlot(Lane* lane);
+    void Log(const std::string& msg) const;
+
+    BotReplyRouter& router_;
+    Options opts_;
+    LogFn logger_;
+
+    mutable std::mutex mu_;
+    std::map<std::string, std::unique_ptr<Lane>> lanes_;
+    std::map<std::string, std::unique_ptr<PlatformWindow>> platform_windows_;
+    std::atomic<bool> stopped_{ false };
+};
@@ -13,9 +13,16 @@ struct BotReplyTarget {
     std::string channel_id;
 };
 
+// Outcome of one send attempt.
+enum class BotSendResult {
+    Sent,
+    Failed,    // nothing reached the platform; safe to retry
+    Uncertain  // the request may have been delivered (e.g. HTTP timeout); retrying could post twice
+};
+
 class BotReplyRouter {
 public:
-    using SendFn = std::function<bool(const BotReplyTarget& target, const std::string& text)>;
+    using SendFn = std::function<BotSendResult(const BotReplyTarget& target, const std::string& text)>;
     using LogFn = std::function<void(const std::string&)>;
 
     // Optional: receive debug messages when a send fails.
@@ -37,29 +44,40 @@ public:
         Log("BotReplyRouter: registered alias '" + alias_key + "' -> '" + canonical_key + "'");
     }
 
-    // Send a reply to the origin platform only.
-    // Returns false if platform not registered or send failed.
-    bool Send(const BotReplyTarget& target, const std::string& text) const {
-        // Normalize platform key from target (fixes "Twitch" vs "twitch" issues)
-        std::string key = ToLower(target.platform_lc);
-
-        // Resolve alias if present
+    // Canonical sender key for a platform label (lowercased, alias resolved).
+    std::string Resolve(const std::string& platform) const {
+        std::string key = ToLower(platform);
         auto ali = aliases_.find(key);
         if (ali != aliases_.end()) key = ali->second;
+        return key;
+    }
+
+    bool HasSender(const std::string& platform) const {
+        return senders_.find(Resolve(platform)) != senders_.end();
+    }
+
+    // Send a reply to the origin platform only.
+    // Returns Failed if the platform is not registered.
+    // Register senders at startup; Send() may then be called from several threads.
+    BotSendResult Send(const BotReplyTarget& target, const std::string& text) const {
+        // Normalize platform key from target (fixes "Twitch" vs "twitch" issues)
+        // and resolve alias if present.
+        const std::string key = Resolve(target.platform_lc);
 
         auto it = senders_.find(key);
         if (it == senders_.end()) {
             Log("BotReplyRouter: no sender registered for platform '" + key +
                 "' (original='" + target.platform_lc + "')");
-            return false;
+            return BotSendResult::Failed;
         }
 
-        const bool ok = it->second(target, text);
-        if (!ok) {
-            Log("BotReplyRouter: sender for '" + key + "' reported failure. "
+        const BotSendResult r = it->second(target, text);
+        if (r != BotSendResult::Sent) {
+            Log("BotReplyRouter: sender for '" + key + "' reported " +
+                (r == BotSendResult::Uncertain ? "an uncertain outcome" : "failure") + ". "
                 "channel_id='" + target.channel_id + "', text_len=" + std::to_string(text.size()));
         }
-        return ok;
+        return r;
     }
 
     static std::string ToLower(std::string s) {
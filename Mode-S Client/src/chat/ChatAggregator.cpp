@@ -1,43 +1,279 @@
 #include "chat/ChatAggregator.h"
 
 #include <algorithm>
-#include <functional>
 #include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <thread>
+
+struct ChatAggregator::Subscriber
+{
+    struct Item {
+        std::shared_ptr<const ChatMessage> msg;
+        std::chrono::steady_clock::time_point enqueued;
+    };
+
+    SubscriptionId id = 0;
+    SubscribeOptions opts;
+    std::function<void(const ChatMessage&)> cb;
+
+    std::mutex mu;
+    std::condition_variable cv_not_empty;
+    std::condition_variable cv_not_full;
+    std::deque<Item> queue;
+    bool stop = false;
+
+    // Counters (guarded by mu).
+    std::uint64_t enqueued = 0;
+    std::uint64_t delivered = 0;
+    std::uint64_t dropped = 0;
+    size_t high_water = 0;
+    std::int64_t last_lag_ms = 0;
+    std::int64_t max_lag_ms = 0;
+
+    std::thread thread;
+
+    void Enqueue(const std::shared_ptr<const ChatMessage>& msg)
+    {
+        std::unique_lock<std::mutex> lock(mu);
+        if (stop) return;
+
+        if (queue.size() >= opts.queue_capacity) {
+            if (opts.overflow == OverflowPolicy::Block) {
+                cv_not_full.wait(lock, [this]() { return stop || queue.size() < opts.queue_capacity; });
+                if (stop) return;
+            }
+            else {
+                queue.pop_front();
+                ++dropped;
+            }
+        }
+
+        queue.push_back(Item{ msg, std::chrono::steady_clock::now() });
+        ++enqueued;
+        high_water = std::max(high_water, queue.size());
+        lock.unlock();
+        cv_not_empty.notify_one();
+    }
+
+    void Run()
+    {
+        for (;;) {
+            Item item;
+            {
+                std::unique_lock<std::mutex> lock(mu);
+                cv_not_empty.wait(lock, [this]() { return stop || !queue.empty(); });
+                if (stop) return;
+                item = std::move(queue.front());
+                queue.pop_front();
+            }
+            cv_not_full.notify_one();
+
+            const std::int64_t lag_ms = (std::int64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - item.enqueued).count();
+
+            try {
+                cb(*item.msg);
+            }
+            catch (...) {
+                // A throwing subscriber must not kill its dispatch thread.
+            }
+
+            std::lock_guard<std::mutex> lock(mu);
+            ++delivered;
+            last_lag_ms = lag_ms;
+            max_lag_ms = std::max(max_lag_ms, lag_ms);
+        }
+    }
+};
 
 ChatAggregator::ChatAggregator(size_t capacity)
     : capacity_(capacity) {}
 
-void ChatAggregator::Subscribe(std::function<void(const ChatMessage&)> cb)
+ChatAggregator::~ChatAggregator()
+{
+    StopSubscribers();
+}
+
+ChatAggregator::SubscriptionId ChatAggregator::Subscribe(std::function<void(const ChatMessage&)> cb)
+{
+    return Subscribe(std::move(cb), SubscribeOptions{});
+}
+
+ChatAggregator::SubscriptionId ChatAggregator::Subscribe(std::function<void(const ChatMessage&)> cb, const SubscribeOptions& opts)
 {
+    if (!cb) return 0;
+
+    auto sub = std::make_shared<Subscriber>();
+    sub->opts = opts;
+    if (sub->opts.queue_capacity == 0) sub->opts.queue_capacity = 1;
+    sub->cb = std::move(cb);
+
+    // The thread holds its own reference: after a self-unsubscribe detaches it, the subscriber
+    // (and the callback still on its stack) lives until Run() returns. Started before the
+    // subscriber is published, so Unsubscribe()/StopSubscribers() never see `thread` being set.
+    sub->thread = std::thread([sub]() { sub->Run(); });
+
     std::lock_guard<std::mutex> lock(mu_);
-    on_add_ = std::move(cb);
+    sub->id = next_subscription_id_++;
+    if (sub->opts.name.empty()) sub->opts.name = "subscriber-" + std::to_string(sub->id);
+    subscribers_.push_back(sub);
+    return sub->id;
+}
+
+void ChatAggregator::StopSubscriber(const std::shared_ptr<Subscriber>& sub)
+{
+    {
+        std::lock_guard<std::mutex> lock(sub->mu);
+        sub->stop = true;
+        sub->queue.clear();
+    }
+    sub->cv_not_empty.notify_all();
+    sub->cv_not_full.notify_all();
+
+    if (sub->thread.joinable()) {
+        if (std::this_thread::get_id() == sub->thread.get_id()) {
+            // Unsubscribing from inside the callback itself: the thread keeps `sub` alive and
+            // exits once the callback returns and it sees `stop`.
+            sub->thread.detach();
+        }
+        else {
+            sub->thread.join();
+        }
+    }
+}
+
+void ChatAggregator::Unsubscribe(SubscriptionId id)
+{
+    std::shared_ptr<Subscriber> victim;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = std::find_if(subscribers_.begin(), subscribers_.end(),
+            [id](const auto& s) { return s->id == id; });
+        if (it == subscribers_.end()) return;
+        victim = *it;
+        subscribers_.erase(it);
+    }
+    StopSubscriber(victim);
+}
+
+void ChatAggregator::StopSubscribers()
+{
+    std::vector<std::shared_ptr<Subscriber>> subs;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        subs.swap(subscribers_);
+    }
+    for (const auto& sub : subs) StopSubscriber(sub);
+}
+
+nlohmann::json ChatAggregator::SubscribersJson() const
+{
+    std::vector<std::shared_ptr<Subscriber>> subs;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        subs = subscribers_;
+    }
+
+    nlohmann::json out = nlohmann::json::array();
+    for (const auto& sub : subs) {
+        std::lock_guard<std::mutex> lock(sub->mu);
+        out.push_back({
+            {"id", sub->id},
+            {"name", sub->opts.name},
+            {"overflow", sub->opts.overflow == OverflowPolicy::Block ? "block" : "drop_oldest"},
+            {"queue_capacity", sub->opts.queue_capacity},
+            {"queued", sub->queue.size()},
+            {"high_water", sub->high_water},
+            {"enqueued", sub->enqueued},
+            {"delivered", sub->delivered},
+            {"dropped", sub->dropped},
+            {"last_lag_ms", sub->last_lag_ms},
+            {"max_lag_ms", sub->max_lag_ms}
+        });
+    }
+    return out;
 }
 
 void ChatAggregator::Add(ChatMessage msg)
 {
-    std::function<void(const ChatMessage&)> cb;
-    ChatMessage notify;
-    bool do_notify = false;
+    // Normalize platform to lowercase for consistent overlay rendering and dedupe.
+    std::string platform_lc = msg.platform;
+    std::transform(platform_lc.begin(), platform_lc.end(), platform_lc.begin(), [](unsigned char c){ return (char)std::tolower(c); });
+
+    std::vector<std::shared_ptr<Subscriber>> subs;
+    std::shared_ptr<const ChatMessage> shared;
     {
         std::lock_guard<std::mutex> lock(mu_);
         if (capacity_ == 0) return;
 
+        Entry e;
+        e.seq = next_seq_++;
+        e.msg = tables_.Pack(msg, platform_lc);
+        e.json = EntryToJsonUnlocked(e).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+
+        if (!subscribers_.empty()) {
+            // One immutable copy shared by every subscriber queue.
+            shared = std::make_shared<const ChatMessage>(std::move(msg));
+            subs = subscribers_;
+        }
+
         while (ring_.size() >= capacity_) {
+            tables_.Release(ring_.front().msg);
             ring_.pop_front();
         }
-        ring_.push_back(std::move(msg));
-        cb = on_add_;
-        if (cb) {
-            notify = ring_.back();
-            do_notify = true;
+        ring_.push_back(std::move(e));
+
+        // Only the window overlays actually poll keeps its cached fragment; older entries
+        // are serialized on demand from the compact form.
+        if (ring_.size() > kFragmentCacheWindow) {
+            std::string().swap(ring_[ring_.size() - 1 - kFragmentCacheWindow].json);
         }
     }
 
-    // Invoke callback outside the lock.
-    if (do_notify) {
-        // NOTE: callback is invoked on the calling thread of Add(). Keep it fast.
-        cb(notify);
+    // Hand off outside the lock; dispatch happens on each subscriber's own thread.
+    for (const auto& sub : subs) {
+        sub->Enqueue(shared);
+    }
+}
+
+nlohmann::json ChatAggregator::EntryToJsonUnlocked(const Entry& e) const
+{
+    const auto& m = e.msg;
+    const std::string& platform = tables_.PlatformName(m);
+    const std::string& user = m.user ? *m.user : std::string();
+
+    // Generate a stable-ish id if not provided by upstream: platform|user|ts_ms|message-hash
+    std::size_t msgHash = std::hash<std::string>{}(m.message);
+    std::string id = platform + "|" + user + "|" + std::to_string(m.ts_ms) + "|" + std::to_string(msgHash);
+
+    nlohmann::json item = {
+        {"seq", e.seq},
+        {"platform", platform},
+        {"user", user},
+        {"message", m.message},
+        {"ts_ms", m.ts_ms},
+        {"id", std::move(id)},
+        {"color", m.color ? *m.color : std::string()}
+    };
+
+    // Optional role flags (used by bot scope; helpful for debugging).
+    if (m.flags & CompactChatMessage::kFlagMod) item["is_mod"] = true;
+    if (m.flags & CompactChatMessage::kFlagBroadcaster) item["is_broadcaster"] = true;
+    if (m.flags & CompactChatMessage::kFlagEvent) item["is_event"] = true;
+
+    // Include rich runs when present (YouTube custom emojis, etc.)
+    if (!m.runs.empty() || !m.runs_fallback.is_null()) {
+        item["runs"] = tables_.RunsJson(m);
     }
+    return item;
+}
+
+std::string ChatAggregator::FragmentUnlocked(const Entry& e) const
+{
+    if (!e.json.empty()) return e.json;
+    return EntryToJsonUnlocked(e).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
 }
 
 nlohmann::json ChatAggregator::RecentJson(size_t limit) const
@@ -49,39 +285,102 @@ nlohmann::json ChatAggregator::RecentJson(size_t limit) const
 
     nlohmann::json out = nlohmann::json::array();
     for (size_t i = start; i < n; ++i) {
-        const auto& m = ring_[i];
-        // Normalize platform to lowercase for consistent overlay rendering and dedupe.
-        std::string platform = m.platform;
-        std::transform(platform.begin(), platform.end(), platform.begin(), [](unsigned char c){ return (char)std::tolower(c); });
-
-        // Generate a stable-ish id if not provided by upstream: platform|user|ts_ms|message-hash
-        std::size_t msgHash = std::hash<std::string>{}(m.message);
-        std::string id = platform + "|" + m.user + "|" + std::to_string(m.ts_ms) + "|" + std::to_string(msgHash);
-
-        nlohmann::json item = {
-            {"platform", platform},
-            {"user", m.user},
-            {"message", m.message},
-            {"ts_ms", m.ts_ms},
-            {"id", id},
-            {"color", m.color}
-        };
-
-        // Optional role flags (used by bot scope; helpful for debugging).
-        if (m.is_mod) item["is_mod"] = true;
-        if (m.is_broadcaster) item["is_broadcaster"] = true;
-        if (m.is_event) item["is_event"] = true;
-
-        // Include rich runs when present (YouTube custom emojis, etc.)
-        if (m.runs.is_array() && !m.runs.empty()) {
-            item["runs"] = m.runs;
-        }
+        out.push_back(EntryToJsonUnlocked(ring_[i]));
+    }
+    return out;
+}
+
+void ChatAggregator::SinceRangeUnlocked(std::uint64_t since_seq, size_t limit, size_t& start, size_t& end, std::uint64_t* out_latest_seq) const
+{
+    const std::uint64_t latest = next_seq_ - 1;
+    const size_t n = ring_.size();
+
+    // Sequence numbers in the ring are contiguous, so the cursor maps straight to an index.
+    start = 0;
+    if (since_seq > latest) {
+        // Client cursor is from a previous run; resync with the most recent window.
+        start = (n > limit) ? (n - limit) : 0;
+    }
+    else if (n > 0 && since_seq >= ring_.front().seq) {
+        start = (size_t)(since_seq - ring_.front().seq) + 1;
+    }
+    end = std::min(n, start + limit);
+
+    if (out_latest_seq) {
+        // When truncated by limit, hand back the last returned seq so the client catches up next poll.
+        *out_latest_seq = (end > start) ? ring_[end - 1].seq : latest;
+    }
+}
+
+std::string ChatAggregator::JoinFragmentsUnlocked(size_t start, size_t end) const
+{
+    size_t total = 2;
+    for (size_t i = start; i < end; ++i) total += ring_[i].json.size() + 1;
 
-        out.push_back(std::move(item));
+    std::string out;
+    out.reserve(total);
+    out.push_back('[');
+    for (size_t i = start; i < end; ++i) {
+        if (i != start) out.push_back(',');
+        if (!ring_[i].json.empty()) out += ring_[i].json;
+        else out += FragmentUnlocked(ring_[i]);
     }
+    out.push_back(']');
     return out;
 }
 
+nlohmann::json ChatAggregator::RecentJson(std::uint64_t since_seq, size_t limit, std::uint64_t* out_latest_seq) const
+{
+    std::lock_guard<std::mutex> lock(mu_);
+
+    size_t start = 0, end = 0;
+    SinceRangeUnlocked(since_seq, limit, start, end, out_latest_seq);
+
+    nlohmann::json out = nlohmann::json::array();
+    for (size_t i = start; i < end; ++i) {
+        out.push_back(EntryToJsonUnlocked(ring_[i]));
+    }
+    return out;
+}
+
+std::string ChatAggregator::RecentJsonText(size_t limit, std::uint64_t* out_latest_seq) const
+{
+    std::lock_guard<std::mutex> lock(mu_);
+
+    const size_t n = ring_.size();
+    const size_t start = (n > limit) ? (n - limit) : 0;
+    if (out_latest_seq) *out_latest_seq = next_seq_ - 1;
+    return JoinFragmentsUnlocked(start, n);
+}
+
+std::string ChatAggregator::RecentJsonText(std::uint64_t since_seq, size_t limit, std::uint64_t* out_latest_seq) const
+{
+    std::lock_guard<std::mutex> lock(mu_);
+
+    size_t start = 0, end = 0;
+    SinceRangeUnlocked(since_seq, limit, start, end, out_latest_seq);
+    return JoinFragmentsUnlocked(start, end);
+}
+
+std::vector<std::string> ChatAggregator::RecentFragments(std::uint64_t since_seq, size_t limit, std::uint64_t* out_latest_seq) const
+{
+    std::lock_guard<std::mutex> lock(mu_);
+
+    size_t start = 0, end = 0;
+    SinceRangeUnlocked(since_seq, limit, start, end, out_latest_seq);
+
+    std::vector<std::string> out;
+    out.reserve(end - start);
+    for (size_t i = start; i < end; ++i) out.push_back(FragmentUnlocked(ring_[i]));
+    return out;
+}
+
+std::uint64_t ChatAggregator::LatestSeq() const
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    return next_seq_ - 1;
+}
+
 size_t ChatAggregator::Size() const
 {
     std::lock_guard<std::mutex> lock(mu_);
@@ -91,5 +390,6 @@ size_t ChatAggregator::Size() const
 void ChatAggregator::Clear()
 {
     std::lock_guard<std::mutex> lock(mu_);
+    for (const auto& e : ring_) tables_.Release(e.msg);
     ring_.clear();
 }
@@ -1,33 +1,86 @@
 #pragma once
 
+#include <cstdint>
 #include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 
 #include "json.hpp"
 
 // Reuse the project's canonical ChatMessage definition.
 #include "AppState.h"
+#include "chat/CompactChatMessage.h"
 
 // Thread-safe aggregator / ring buffer for combined live chat.
 // Platform adapters call Add(...). UI / overlay can query RecentJson().
 class ChatAggregator
 {
 public:
-    explicit ChatAggregator(size_t capacity = 200);
+    // Messages are stored compactly (see CompactChatMessage.h), so the ring can hold a whole stream.
+    static constexpr size_t kDefaultCapacity = 20000;
 
-    // Subscribe to newly added messages.
-    // Callback will be invoked on the calling thread of Add(). Keep it fast.
-    void Subscribe(std::function<void(const ChatMessage&)> cb);
+    explicit ChatAggregator(size_t capacity = kDefaultCapacity);
+    ~ChatAggregator();
+
+    ChatAggregator(const ChatAggregator&) = delete;
+    ChatAggregator& operator=(const ChatAggregator&) = delete;
+
+    using SubscriptionId = std::uint64_t;
+
+    // What Add() does when a subscriber's queue is full.
+    enum class OverflowPolicy {
+        DropOldest, // discard the oldest queued message (default; ingest never stalls)
+        Block       // wait for space (only for consumers that must see every message)
+    };
+
+    struct SubscribeOptions {
+        std::string name;               // shown in SubscribersJson()
+        size_t queue_capacity = 1024;
+        OverflowPolicy overflow = OverflowPolicy::DropOldest;
+    };
+
+    // Subscribe to newly added messages. Each subscriber gets its own bounded queue and
+    // dispatch thread, so a slow callback never stalls the platform thread calling Add().
+    // Callbacks for one subscriber run sequentially, in Add() order.
+    SubscriptionId Subscribe(std::function<void(const ChatMessage&)> cb);
+    SubscriptionId Subscribe(std::function<void(const ChatMessage&)> cb, const SubscribeOptions& opts);
+
+    // Stops the subscriber's dispatch thread (queued messages are discarded). Unknown ids are ignored.
+    void Unsubscribe(SubscriptionId id);
+
+    // Stops every subscriber. Used at shutdown before the services callbacks reply through go away.
+    void StopSubscribers();
+
+    // Per-subscriber diagnostics: queue depth, delivered/dropped counts and dispatch lag.
+    nlohmann::json SubscribersJson() const;
 
     // Adds a normalized message. Safe to call from any thread.
+    // Each message is assigned a monotonically increasing sequence number.
     void Add(ChatMessage msg);
 
     // Returns most recent messages (oldest->newest) as a JSON array.
     // Safe to call from any thread.
     nlohmann::json RecentJson(size_t limit = 100) const;
 
+    // Incremental mode: returns up to `limit` messages with seq > since_seq (oldest->newest).
+    // out_latest_seq receives the cursor to pass as since_seq on the next call.
+    // If since_seq is ahead of the buffer (e.g. after a restart) the most recent window is returned.
+    nlohmann::json RecentJson(std::uint64_t since_seq, size_t limit, std::uint64_t* out_latest_seq) const;
+
+    // Same as RecentJson, but returns a compact JSON array assembled from the fragments
+    // serialized once at Add() time (no per-request DOM building).
+    std::string RecentJsonText(size_t limit = 100, std::uint64_t* out_latest_seq = nullptr) const;
+    std::string RecentJsonText(std::uint64_t since_seq, size_t limit, std::uint64_t* out_latest_seq) const;
+
+    // Individual pre-serialized items (seq > since_seq), e.g. for push streams.
+    std::vector<std::string> RecentFragments(std::uint64_t since_seq, size_t limit, std::uint64_t* out_latest_seq) const;
+
+    // Sequence number of the newest message (0 when nothing was added yet).
+    std::uint64_t LatestSeq() const;
+
     // Current number of buffered messages.
     size_t Size() const;
 
@@ -36,8 +89,31 @@ public:
     bool is_event = false;
 
 private:
+    // Number of newest entries that keep their pre-serialized fragment (/api/chat max limit).
+    static constexpr size_t kFragmentCacheWindow = 1000;
+
+    struct Entry {
+        std::uint64_t seq = 0;
+        CompactChatMessage msg;
+        std::string json; // compact serialized item; only kept for the newest kFragmentCacheWindow entries
+    };
+
+    nlohmann::json EntryToJsonUnlocked(const Entry& e) const;
+    std::string FragmentUnlocked(const Entry& e) const;
+
+    // Index range [start, end) for an incremental read. Caller holds mu_.
+    void SinceRangeUnlocked(std::uint64_t since_seq, size_t limit, size_t& start, size_t& end, std::uint64_t* out_latest_seq) const;
+    std::string JoinFragmentsUnlocked(size_t start, size_t end) const;
+
     size_t capacity_;
     mutable std::mutex mu_;
-    std::deque<ChatMessage> ring_;
-    std::function<void(const ChatMessage&)> on_add_;
+    std::deque<Entry> ring_;
+    CompactChatTables tables_;
+    std::uint64_t next_seq_ = 1;
+
+    struct Subscriber;
+    static void StopSubscriber(const std::shared_ptr<Subscriber>& sub);
+
+    std::vector<std::shared_ptr<Subscriber>> subscribers_;
+    SubscriptionId next_subscription_id_ = 1;
 };
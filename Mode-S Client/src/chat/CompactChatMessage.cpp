@@ -0,0 +1,172 @@
+#include "chat/CompactChatMessage.h"
+
+#include <limits>
+
+ChatPlatform ParseChatPlatform(const std::string& platform_lc)
+{
+    if (platform_lc == "twitch") return ChatPlatform::Twitch;
+    if (platform_lc == "youtube") return ChatPlatform::YouTube;
+    if (platform_lc == "tiktok") return ChatPlatform::TikTok;
+    return ChatPlatform::Other;
+}
+
+const std::string* CompactChatTables::InternString(const std::string& s)
+{
+    auto it = strings_.find(s);
+    if (it == strings_.end()) {
+        it = strings_.emplace(s, 0u).first;
+    }
+    ++it->second;
+    return &it->first;
+}
+
+void CompactChatTables::ReleaseString(const std::string* s)
+{
+    if (!s) return;
+    auto it = strings_.find(*s);
+    if (it == strings_.end()) return;
+    if (--it->second == 0) strings_.erase(it);
+}
+
+std::int32_t CompactChatTables::InternEmote(nlohmann::json def)
+{
+    std::string key = def.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+
+    auto it = emote_index_.find(key);
+    if (it != emote_index_.end()) {
+        ++emotes_[(size_t)it->second].refs;
+        return it->second;
+    }
+
+    std::int32_t idx;
+    if (!free_emotes_.empty()) {
+        idx = free_emotes_.back();
+        free_emotes_.pop_back();
+    }
+    else {
+        idx = (std::int32_t)emotes_.size();
+        emotes_.emplace_back();
+    }
+
+    auto& slot = emotes_[(size_t)idx];
+    slot.def = std::move(def);
+    slot.key = key;
+    slot.refs = 1;
+    emote_index_.emplace(std::move(key), idx);
+    return idx;
+}
+
+void CompactChatTables::ReleaseEmote(std::int32_t idx)
+{
+    if (idx < 0 || (size_t)idx >= emotes_.size()) return;
+    auto& slot = emotes_[(size_t)idx];
+    if (slot.refs == 0 || --slot.refs > 0) return;
+
+    emote_index_.erase(slot.key);
+    slot.def = nullptr;
+    slot.key.clear();
+    free_emotes_.push_back(idx);
+}
+
+bool CompactChatTables::PackRuns(const nlohmann::json& runs, const std::string& message, std::vector<ChatRunSpan>& out)
+{
+    if (message.size() > std::numeric_limits<std::uint32_t>::max()) return false;
+
+    auto fail = [&]() {
+        for (const auto& s : out) ReleaseEmote(s.emote);
+        out.clear();
+        return false;
+    };
+
+    size_t cursor = 0;
+    out.reserve(runs.size());
+    for (const auto& run : runs) {
+        if (!run.is_object()) return fail();
+        const auto t = run.find("t");
+        if (t == run.end() || !t->is_string()) return fail();
+
+        const std::string& kind = t->get_ref<const std::string&>();
+        if (kind == "text") {
+            const auto text = run.find("text");
+            if (run.size() != 2 || text == run.end() || !text->is_string()) return fail();
+            const std::string& s = text->get_ref<const std::string&>();
+            if (message.compare(cursor, s.size(), s) != 0) return fail();
+
+            out.push_back(ChatRunSpan{ (std::uint32_t)cursor, (std::uint32_t)s.size(), -1 });
+            cursor += s.size();
+        }
+        else if (kind == "emoji") {
+            const auto sc = run.find("shortcut");
+            if (sc == run.end() || !sc->is_string()) return fail();
+            const std::string& s = sc->get_ref<const std::string&>();
+            if (message.compare(cursor, s.size(), s) != 0) return fail();
+
+            nlohmann::json def = run;
+            def.erase("shortcut");
+            out.push_back(ChatRunSpan{ (std::uint32_t)cursor, (std::uint32_t)s.size(), InternEmote(std::move(def)) });
+            cursor += s.size();
+        }
+        else {
+            return fail();
+        }
+    }
+    out.shrink_to_fit();
+    return true;
+}
+
+CompactChatMessage CompactChatTables::Pack(const ChatMessage& m, const std::string& platform_lc)
+{
+    CompactChatMessage c;
+    c.ts_ms = m.ts_ms;
+    c.platform = ParseChatPlatform(platform_lc);
+    if (c.platform == ChatPlatform::Other) c.platform_other = InternString(platform_lc);
+    c.user = InternString(m.user);
+    c.color = InternString(m.color);
+    c.message = m.message;
+
+    if (m.is_mod) c.flags |= CompactChatMessage::kFlagMod;
+    if (m.is_broadcaster) c.flags |= CompactChatMessage::kFlagBroadcaster;
+    if (m.is_event) c.flags |= CompactChatMessage::kFlagEvent;
+
+    if (m.runs.is_array() && !m.runs.empty()) {
+        if (!PackRuns(m.runs, c.message, c.runs)) {
+            c.runs_fallback = m.runs;
+        }
+    }
+    return c;
+}
+
+void CompactChatTables::Release(const CompactChatMessage& c)
+{
+    ReleaseString(c.platform_other);
+    ReleaseString(c.user);
+    ReleaseString(c.color);
+    for (const auto& s : c.runs) ReleaseEmote(s.emote);
+}
+
+const std::string& CompactChatTables::PlatformName(const CompactChatMessage& c) const
+{
+    static const std::string kNames[] = { "", "twitch", "youtube", "tiktok" };
+    if (c.platform == ChatPlatform::Other) {
+        return c.platform_other ? *c.platform_other : kNames[0];
+    }
+    return kNames[(size_t)c.platform];
+}
+
+nlohmann::json CompactChatTables::RunsJson(const CompactChatMessage& c) const
+{
+    if (!c.runs_fallback.is_null()) return c.runs_fallback;
+
+    nlohmann::json out = nlohmann::json::array();
+    for (const auto& s : c.runs) {
+        std::string text = c.message.substr(s.offset, s.len);
+        if (s.emote < 0 || (size_t)s.emote >= emotes_.size()) {
+            out.push_back({ {"t", "text"}, {"text", std::move(text)} });
+            continue;
+        }
+        nlohmann::json run = emotes_[(size_t)s.emote].def;
+        run["shortcut"] = std::move(text);
+        out.push_back(std::move(run));
+    }
+    return out;
+}
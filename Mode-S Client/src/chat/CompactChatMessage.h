@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "json.hpp"
+
+// Reuse the project's canonical ChatMessage definition.
+#include "AppState.h"
+
+// Compact storage form for buffered chat.
+//
+// ChatMessage stays the ingest/interchange type used by the platform adapters. The chat ring
+// stores CompactChatMessage instead: a platform enum, interned user/colour strings, and emote
+// runs flattened into spans over `message` that reference a shared emote table. JSON is only
+// produced at serialization time.
+
+enum class ChatPlatform : std::uint8_t {
+    Other = 0,
+    Twitch,
+    YouTube,
+    TikTok
+};
+
+ChatPlatform ParseChatPlatform(const std::string& platform_lc);
+
+// One run of a rich message. Text and emote runs both cover [offset, offset+len) of the
+// message text (Twitch/YouTube emote shortcuts appear verbatim in the plain message).
+struct ChatRunSpan {
+    std::uint32_t offset = 0;
+    std::uint32_t len = 0;
+    std::int32_t emote = -1; // index into CompactChatTables emotes, -1 for text
+};
+
+struct CompactChatMessage {
+    std::int64_t ts_ms = 0;
+    ChatPlatform platform = ChatPlatform::Other;
+    std::uint8_t flags = 0;                 // kFlag* bits
+    const std::string* platform_other = nullptr; // interned lowercase name when platform == Other
+    const std::string* user = nullptr;      // interned
+    const std::string* color = nullptr;     // interned ("" when absent)
+    std::string message;
+    std::vector<ChatRunSpan> runs;          // empty when the message has no rich runs
+
+    // Runs that could not be expressed as spans (text did not line up with `message`).
+    // Rare; kept verbatim so nothing is lost.
+    nlohmann::json runs_fallback;
+
+    static constexpr std::uint8_t kFlagMod = 1u << 0;
+    static constexpr std::uint8_t kFlagBroadcaster = 1u << 1;
+    static constexpr std::uint8_t kFlagEvent = 1u << 2;
+};
+
+// Intern tables shared by every buffered message. Not thread-safe: the owner (ChatAggregator)
+// guards all calls with its own mutex. Entries are reference counted and released when the
+// last message using them leaves the ring.
+class CompactChatTables {
+public:
+    // Converts an incoming message. `platform_lc` is the already lowercased platform name.
+    CompactChatMessage Pack(const ChatMessage& m, const std::string& platform_lc);
+
+    // Drops the references held by a message that is leaving the ring.
+    void Release(const CompactChatMessage& c);
+
+    // Lowercase platform name used in JSON output.
+    const std::string& PlatformName(const CompactChatMessage& c) const;
+
+    // Rebuilds the `runs` array in the same shape the adapters produced.
+    nlohmann::json RunsJson(const CompactChatMessage& c) const;
+
+private:
+    const std::string* InternString(const std::string& s);
+    void ReleaseString(const std::string* s);
+
+    std::int32_t InternEmote(nlohmann::json def);
+    void ReleaseEmote(std::int32_t idx);
+
+    bool PackRuns(const nlohmann::json& runs, const std::string& message, std::vector<ChatRunSpan>& out);
+
+    // Key -> refcount. unordered_map nodes are stable, so &key is the interned pointer.
+    std::unordered_map<std::string, std::uint32_t> strings_;
+
+    struct EmoteSlot {
+        nlohmann::json def; // emoji run without its "shortcut" (that comes from the message text)
+        std::string key;
+        std::uint32_t refs = 0;
+    };
+    std::vector<EmoteSlot> emotes_;
+    std::vector<std::int32_t> free_emotes_;
+    std::unordered_map<std::string, std::int32_t> emote_index_;
+};
@@ -0,0 +1,316 @@
+#include "core/ConfigWriteBehind.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+    constexpr std::int64_t kRetryMs = 5000; // after a failed flush
+
+    std::int64_t WallMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    std::string PathKey(const std::filesystem::path& path)
+    {
+        std::error_code ec;
+        auto abs = std::filesystem::absolute(path, ec);
+        return (ec ? path : abs).lexically_normal().u8string();
+    }
+
+    // Object at `ptr`, creating it (or replacing a non-object) as needed.
+    nlohmann::json& ObjectAt(nlohmann::json& doc, const nlohmann::json::json_pointer& ptr)
+    {
+        if (ptr.empty()) {
+            if (!doc.is_object()) doc = nlohmann::json::object();
+            return doc;
+        }
+        nlohmann::json& parent = ObjectAt(doc, ptr.parent_pointer());
+        nlohmann::json& child = parent[ptr.back()];
+        if (!child.is_object()) child = nlohmann::json::object();
+        return child;
+    }
+
+    bool WriteFileAtomic(const std::filesystem::path& p, const std::string& content)
+    {
+        std::error_code ec;
+        if (!p.parent_path().empty()) std::filesystem::create_directories(p.parent_path(), ec);
+
+        auto tmp = p;
+        tmp += ".tmp";
+        {
+            std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+            if (!f) return false;
+            f.write(content.data(), (std::streamsize)content.size());
+            if (!f) return false;
+        }
+
+        ec.clear();
+        std::filesystem::rename(tmp, p, ec);
+        if (ec) {
+            // On Windows, rename fails if target exists; fall back to remove+rename.
+            std::filesystem::remove(p, ec);
+            ec.clear();
+            std::filesystem::rename(tmp, p, ec);
+            if (ec) {
+                std::filesystem::remove(tmp, ec);
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+ConfigWriteBehind::~ConfigWriteBehind()
+{
+    Stop();
+}
+
+void ConfigWriteBehind::Set(const std::filesystem::path& path, const std::string& pointer, nlohmann::json value)
+{
+    Submit(path, pointer, false, std::move(value));
+}
+
+void ConfigWriteBehind::Erase(const std::filesystem::path& path, const std::string& pointer)
+{
+    Submit(path, pointer, true, nullptr);
+}
+
+void ConfigWriteBehind::Submit(const std::filesystem::path& path, const std::string& pointer, bool erase, nlohmann::json value)
+{
+    const std::string key = PathKey(path);
+    bool write_now = false;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (pending_.empty()) first_pending_ = std::chrono::steady_clock::now();
+
+        auto& ops = pending_[key];
+        auto it = ops.find(pointer);
+        if (it != ops.end()) ++stats_.coalesced;
+        Op& op = (it != ops.end()) ? it->second : ops[pointer];
+        op.seq = next_seq_++;
+        op.erase = erase;
+        op.value = std::move(value);
+        ++stats_.submitted;
+
+        if (stopping_) {
+            write_now = true;
+        }
+        else if (!started_) {
+            started_ = true;
+            thread_ = std::thread([this]() { Run(); });
+        }
+    }
+
+    if (write_now) FlushPending(nullptr);
+    else cv_.notify_all();
+}
+
+bool ConfigWriteBehind::Flush(std::string* err)
+{
+    return FlushPending(err);
+}
+
+void ConfigWriteBehind::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        if (stopping_) return;
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+    FlushPending(nullptr);
+}
+
+void ConfigWriteBehind::Run()
+{
+    std::unique_lock<std::mutex> lk(mu_);
+    while (!stopping_) {
+        cv_.wait(lk, [this]() { return stopping_ || !pending_.empty(); });
+        if (stopping_) break;
+
+        // Let a burst of updates collect before touching the disk.
+        const auto due = first_pending_ + std::chrono::milliseconds(kDebounceMs);
+        if (cv_.wait_until(lk, due, [this]() { return stopping_; })) break;
+
+        lk.unlock();
+        FlushPending(nullptr);
+        lk.lock();
+    }
+}
+
+bool ConfigWriteBehind::FlushPending(std::string* err)
+{
+    std::lock_guard<std::mutex> io(io_mu_);
+
+    Pending batch;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        batch.swap(pending_);
+    }
+    if (batch.empty()) return true;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    bool ok = true;
+    std::uint64_t bytes = 0;
+    std::string first_err;
+    Pending failed;
+
+    for (auto& [path, ops] : batch) {
+        std::string e;
+        if (!WriteDocument(path, ops, &bytes, &e)) {
+            ok = false;
+            if (first_err.empty()) first_err = e;
+            failed[path] = std::move(ops);
+        }
+    }
+
+    const std::int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - t0).count();
+
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        ++stats_.flushes;
+        stats_.bytes_written += bytes;
+        stats_.last_bytes = bytes;
+        stats_.last_flush_us = us;
+        stats_.max_flush_us = std::max(stats_.max_flush_us, us);
+        stats_.total_flush_us += us;
+        stats_.last_flush_ms = WallMs();
+
+        if (!ok) {
+            ++stats_.failed_flushes;
+            stats_.last_error = first_err;
+
+            // Put the failed patches back unless a newer value for the same key arrived meanwhile.
+            if (pending_.empty()) {
+                first_pending_ = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(kRetryMs - kDebounceMs);
+            }
+            for (auto& [path, ops] : failed) {
+                auto& dst = pending_[path];
+                for (auto& [ptr, op] : ops) dst.emplace(ptr, std::move(op));
+            }
+        }
+    }
+
+    if (!ok && err) *err = first_err;
+    return ok;
+}
+
+bool ConfigWriteBehind::WriteDocument(const std::string& path, const std::map<std::string, Op>& ops,
+                                      std::uint64_t* bytes, std::string* err)
+{
+    const auto p = std::filesystem::u8path(path);
+    Document& doc = docs_[path];
+
+    // Re-read only when someone else rewrote the file since we last saw it.
+    std::error_code ec;
+    const bool exists = std::filesystem::exists(p, ec) && !ec;
+    std::filesystem::file_time_type mtime{};
+    std::uintmax_t size = 0;
+    if (exists) {
+        mtime = std::filesystem::last_write_time(p, ec);
+        size = std::filesystem::file_size(p, ec);
+    }
+
+    if (!doc.loaded || mtime != doc.mtime || size != doc.size) {
+        nlohmann::json j = nlohmann::json::object();
+        if (exists) {
+            std::ifstream in(p, std::ios::binary);
+            std::string s((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            if (!s.empty()) {
+                try {
+                    j = nlohmann::json::parse(s);
+                }
+                catch (...) {
+                    j = nullptr;
+                }
+                // Never replace a file we could not parse; the user may be mid-edit.
+                if (!j.is_object()) {
+                    if (err) *err = "config is not a JSON object: " + path;
+                    doc.loaded = false;
+                    return false;
+                }
+            }
+        }
+        doc.json = std::move(j);
+        doc.loaded = true;
+        std::lock_guard<std::mutex> lk(mu_);
+        ++stats_.reloads;
+    }
+
+    std::vector<std::pair<const std::string*, const Op*>> ordered;
+    ordered.reserve(ops.size());
+    for (const auto& [ptr, op] : ops) ordered.emplace_back(&ptr, &op);
+    std::sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) { return a.second->seq < b.second->seq; });
+
+    for (const auto& [ptr_str, op] : ordered) {
+        try {
+            const nlohmann::json::json_pointer ptr(*ptr_str);
+            if (ptr.empty()) continue; // whole-document replacement is not supported
+
+            if (op->erase) {
+                const auto parent = ptr.parent_pointer();
+                if (doc.json.contains(parent) && doc.json.at(parent).is_object()) {
+                    doc.json.at(parent).erase(ptr.back());
+                }
+            }
+            else {
+                ObjectAt(doc.json, ptr.parent_pointer())[ptr.back()] = op->value;
+            }
+        }
+        catch (...) {
+            // malformed pointer; drop it
+        }
+    }
+
+    const std::string out = doc.json.dump(2);
+    if (!WriteFileAtomic(p, out)) {
+        if (err) *err = "failed to write config: " + path;
+        return false;
+    }
+
+    ec.clear();
+    doc.mtime = std::filesystem::last_write_time(p, ec);
+    doc.size = std::filesystem::file_size(p, ec);
+    if (bytes) *bytes += out.size();
+    return true;
+}
+
+nlohmann::json ConfigWriteBehind::StatsJson() const
+{
+    std::lock_guard<std::mutex> lk(mu_);
+
+    std::size_t pending_keys = 0;
+    for (const auto& [path, ops] : pending_) pending_keys += ops.size();
+
+    nlohmann::json j;
+    j["debounce_ms"] = kDebounceMs;
+    j["pending_keys"] = pending_keys;
+    j["submitted"] = stats_.submitted;
+    j["coalesced"] = stats_.coalesced;
+    j["flushes"] = stats_.flushes;
+    j["failed_flushes"] = stats_.failed_flushes;
+    j["reloads"] = stats_.reloads;
+    j["bytes_written"] = stats_.bytes_written;
+    j["last_bytes"] = stats_.last_bytes;
+    j["last_flush_us"] = stats_.last_flush_us;
+    j["max_flush_us"] = stats_.max_flush_us;
+    j["avg_flush_us"] = stats_.flushes ? stats_.total_flush_us / (std::int64_t)stats_.flushes : 0;
+    j["last_flush_ms"] = stats_.last_flush_ms;
+    j["last_error"] = stats_.last_error;
+    return j;
+}
+
+ConfigWriteBehind& SharedConfigWriter()
+{
+    static ConfigWriteBehind writer;
+    return writer;
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "json.hpp"
+
+// Write-behind persistence for config.json-backed state.
+//
+// Writers submit patches addressed by JSON pointer ("/metrics_cache", "/twitch/user_access_token")
+// and return immediately. Patches to the same key are coalesced (last one wins) and one
+// background thread applies them to its in-memory copy of the file and writes it atomically
+// (temp file + rename), at most once per kDebounceMs. The document is only re-read when the file
+// changed on disk since our last read/write, so keys owned by other writers (AppConfig::Save,
+// the OAuth helpers) are preserved.
+class ConfigWriteBehind {
+public:
+    static constexpr std::int64_t kDebounceMs = 1000;
+
+    ConfigWriteBehind() = default;
+    ~ConfigWriteBehind();
+
+    ConfigWriteBehind(const ConfigWriteBehind&) = delete;
+    ConfigWriteBehind& operator=(const ConfigWriteBehind&) = delete;
+
+    // Sets (or with Erase, removes) the value at `pointer` in the file at `path`. Missing parent
+    // objects are created; a parent that is not an object is replaced by one.
+    void Set(const std::filesystem::path& path, const std::string& pointer, nlohmann::json value);
+    void Erase(const std::filesystem::path& path, const std::string& pointer);
+
+    // Writes everything submitted so far on the calling thread. For callers that must know the
+    // data reached disk (OAuth tokens).
+    bool Flush(std::string* err = nullptr);
+
+    // Stops the writer thread after a final flush. Later submissions are written synchronously.
+    void Stop();
+
+    // Flush count, latency and bytes written; served at /api/config/persistence.
+    nlohmann::json StatsJson() const;
+
+private:
+    struct Op {
+        std::uint64_t seq = 0;
+        bool erase = false;
+        nlohmann::json value;
+    };
+
+    // In-memory copy of one file; only touched with io_mu_ held.
+    struct Document {
+        bool loaded = false;
+        nlohmann::json json = nlohmann::json::object();
+        std::filesystem::file_time_type mtime{};
+        std::uintmax_t size = 0;
+    };
+
+    using Pending = std::map<std::string, std::map<std::string, Op>>; // path -> pointer -> op
+
+    void Submit(const std::filesystem::path& path, const std::string& pointer, bool erase, nlohmann::json value);
+    void Run();
+    bool FlushPending(std::string* err);
+    bool WriteDocument(const std::string& path, const std::map<std::string, Op>& ops,
+                       std::uint64_t* bytes, std::string* err);
+
+    mutable std::mutex mu_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool started_ = false;
+    bool stopping_ = false;
+
+    // Guarded by mu_.
+    Pending pending_;
+    std::uint64_t next_seq_ = 1;
+    std::chrono::steady_clock::time_point first_pending_{};
+
+    // Serializes flushes (writer thread and synchronous Flush()) and guards docs_.
+    std::mutex io_mu_;
+    std::map<std::string, Document> docs_;
+
+    // Guarded by mu_.
+    struct Stats {
+        std::uint64_t submitted = 0;
+        std::uint64_t coalesced = 0;   // submissions that replaced a still-pending patch
+        std::uint64_t flushes = 0;
+        std::uint64_t failed_flushes = 0;
+        std::uint64_t reloads = 0;     // file changed on disk and was re-read
+        std::uint64_t bytes_written = 0;
+        std::uint64_t last_bytes = 0;
+        std::int64_t last_flush_us = 0;
+        std::int64_t max_flush_us = 0;
+        std::int64_t total_flush_us = 0;
+        std::int64_t last_flush_ms = 0; // wall clock
+        std::string last_error;
+    } stats_;
+};
+
+// Process-wide instance used for config.json.
+ConfigWriteBehind& SharedConfigWriter();
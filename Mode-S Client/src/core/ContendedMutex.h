@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+// std::mutex that counts how often it was found already held, and for how long callers waited.
+// Satisfies Lockable, so it works with std::lock_guard / std::unique_lock unchanged. The
+// uncontended path is one try_lock plus a relaxed increment.
+class ContendedMutex {
+public:
+    void lock() {
+        if (mu_.try_lock()) {
+            acquisitions_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        mu_.lock();
+        const auto waited = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+        acquisitions_.fetch_add(1, std::memory_order_relaxed);
+        contended_.fetch_add(1, std::memory_order_relaxed);
+        wait_us_.fetch_add((std::uint64_t)waited, std::memory_order_relaxed);
+    }
+
+    bool try_lock() {
+        if (!mu_.try_lock()) return false;
+        acquisitions_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void unlock() { mu_.unlock(); }
+
+    std::uint64_t acquisitions() const { return acquisitions_.load(std::memory_order_relaxed); }
+    std::uint64_t contended() const { return contended_.load(std::memory_order_relaxed); }
+    std::uint64_t wait_us() const { return wait_us_.load(std::memory_order_relaxed); }
+
+private:
+    std::mutex mu_;
+    std::atomic<std::uint64_t> acquisitions_{ 0 };
+    std::atomic<std::uint64_t> contended_{ 0 };
+    std::atomic<std::uint64_t> wait_us_{ 0 };
+};
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer sequence lock for small trivially copyable values.
+//
+// Readers never block and never write shared memory: they copy the value and retry if a store
+// overlapped the copy. Store() must be serialized by the caller (one writer at a time). The
+// payload is kept in relaxed atomic words so a torn read is a retry, not a data race.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock requires a trivially copyable type");
+
+public:
+    SeqLock() { Store(T{}); }
+
+    void Store(const T& value) {
+        std::uint64_t buf[kWords] = {};
+        std::memcpy(buf, &value, sizeof(T));
+
+        const std::uint64_t s = seq_.load(std::memory_order_relaxed);
+        seq_.store(s + 1, std::memory_order_relaxed); // odd: write in progress
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) words_[i].store(buf[i], std::memory_order_relaxed);
+        seq_.store(s + 2, std::memory_order_release);
+    }
+
+    T Load() const {
+        std::uint64_t buf[kWords];
+        for (;;) {
+            const std::uint64_t s1 = seq_.load(std::memory_order_acquire);
+            if (s1 & 1) continue;
+            for (std::size_t i = 0; i < kWords; ++i) buf[i] = words_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == s1) break;
+        }
+        T out;
+        std::memcpy(&out, buf, sizeof(T));
+        return out;
+    }
+
+private:
+    static constexpr std::size_t kWords = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::atomic<std::uint64_t> seq_{ 0 };
+    std::atomic<std::uint64_t> words_[kWords];
+};
@@ -0,0 +1,88 @@
+#include "core/SupportEventBus.h"
+
+#include <algorithm>
+
+const char* SupportPlatformName(SupportPlatform p) {
+    switch (p) {
+    case SupportPlatform::Twitch: return "twitch";
+    case SupportPlatform::TikTok: return "tiktok";
+    case SupportPlatform::YouTube: return "youtube";
+    }
+    return "";
+}
+
+SupportEventBus::SubscriptionId SupportEventBus::Subscribe(std::string name, Handler handler) {
+    if (!handler) return 0;
+
+    auto sub = std::make_shared<Subscriber>();
+    sub->handler = std::move(handler);
+
+    std::lock_guard<std::mutex> lk(mu_);
+    const SubscriptionId id = next_id_++;
+    sub->id = id;
+    sub->name = name.empty() ? "subscriber-" + std::to_string(sub->id) : std::move(name);
+
+    auto next = std::make_shared<SubscriberList>(*subscribers_);
+    next->push_back(std::move(sub));
+    subscribers_ = std::move(next);
+    return id;
+}
+
+void SupportEventBus::Unsubscribe(SubscriptionId id) {
+    std::shared_ptr<Subscriber> victim;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        auto next = std::make_shared<SubscriberList>(*subscribers_);
+        auto it = std::find_if(next->begin(), next->end(), [id](const auto& s) { return s->id == id; });
+        if (it == next->end()) return;
+        victim = *it;
+        next->erase(it);
+        subscribers_ = std::move(next);
+    }
+
+    // A Publish() that grabbed the old list may still reach this subscriber; waiting for its
+    // lock lets an in-flight call finish and makes later ones skip it.
+    std::lock_guard<std::mutex> lk(victim->mu);
+    victim->active = false;
+}
+
+void SupportEventBus::Publish(const SupportEvent& ev) const {
+    std::shared_ptr<const SubscriberList> subs;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        subs = subscribers_;
+    }
+
+    for (const auto& sub : *subs) {
+        std::lock_guard<std::mutex> lk(sub->mu);
+        if (!sub->active) continue;
+        try {
+            sub->handler(ev);
+            ++sub->delivered;
+        }
+        catch (...) {
+            // A failing consumer must never break ingest.
+            ++sub->failed;
+        }
+    }
+}
+
+nlohmann::json SupportEventBus::StatsJson() const {
+    std::shared_ptr<const SubscriberList> subs;
+    {
+        std::lock_guard<std::mutex> lk(mu_);
+        subs = subscribers_;
+    }
+
+    nlohmann::json out = nlohmann::json::array();
+    for (const auto& sub : *subs) {
+        std::lock_guard<std::mutex> lk(sub->mu);
+        out.push_back({
+            {"id", sub->id},
+            {"name", sub->name},
+            {"delivered", sub->delivered},
+            {"failed", sub->failed}
+        });
+    }
+    return out;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+
+enum class SupportPlatform { Twitch, TikTok, YouTube };
+
+const char* SupportPlatformName(SupportPlatform p);
+
+// One viewer event (EventSub notification, TikTok gift/like/follow, YouTube superchat, ...) as
+// it enters AppState's event feeds.
+struct SupportEvent {
+    std::uint64_t seq = 0; // event-feed seq, same as the "seq" served by the feed endpoints
+    SupportPlatform platform = SupportPlatform::Twitch;
+    std::string type;
+    std::int64_t ts_ms = 0;
+
+    // Normalized payload as served by /api/<platform>/events. Shared, never copied per subscriber.
+    std::shared_ptr<const nlohmann::json> payload;
+};
+
+// In-process fan-out of SupportEvents to registered consumers.
+//
+// Publish() runs every handler once, in subscription order, on the publishing (platform) thread
+// and outside AppState's locks. Handlers must be quick: hand work to your own thread rather than
+// doing I/O here. Calls to one handler never overlap, and once Unsubscribe() returns the handler
+// is not running and will not be called again. A handler must not (un)subscribe or publish.
+class SupportEventBus {
+public:
+    using SubscriptionId = std::uint64_t;
+    using Handler = std::function<void(const SupportEvent&)>;
+
+    SupportEventBus() = default;
+
+    SupportEventBus(const SupportEventBus&) = delete;
+    SupportEventBus& operator=(const SupportEventBus&) = delete;
+
+    // `name` is shown in StatsJson(). Returns 0 for an empty handler.
+    SubscriptionId Subscribe(std::string name, Handler handler);
+    void Unsubscribe(SubscriptionId id);
+
+    void Publish(const SupportEvent& ev) const;
+
+    // Per-subscriber delivered / failed counts.
+    nlohmann::json StatsJson() const;
+
+private:
+    struct Subscriber {
+        SubscriptionId id = 0;
+        std::string name;
+        Handler handler;
+
+        std::mutex mu; // held while the handler runs
+        bool active = true;
+        std::uint64_t delivered = 0;
+        std::uint64_t failed = 0;
+    };
+    using SubscriberList = std::vector<std::shared_ptr<Subscriber>>;
+
+    // Copy-on-write: Publish() only takes mu_ long enough to grab the current list.
+    mutable std::mutex mu_;
+    std::shared_ptr<const SubscriberList> subscribers_ = std::make_shared<SubscriberList>();
+    SubscriptionId next_id_ = 1;
+};
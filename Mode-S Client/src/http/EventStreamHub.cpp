@@ -0,0 +1,176 @@
+#include "http/EventStreamHub.h"
+
+#include <algorithm>
+#include <cctype>
+
+EventStreamHub::EventStreamHub(std::size_t replay_capacity)
+    : capacity_(std::max<std::size_t>(1, replay_capacity)) {}
+
+unsigned EventStreamHub::ParseTopics(const std::string& csv)
+{
+    unsigned mask = 0;
+    std::string tok;
+    auto flush = [&]() {
+        if (tok == "chat") mask |= kTopicChat;
+        else if (tok == "alerts" || tok == "alert" || tok == "events") mask |= kTopicAlerts;
+        else if (tok == "metrics") mask |= kTopicMetrics;
+        tok.clear();
+    };
+
+    for (char c : csv) {
+        if (c == ',' || c == ' ') { flush(); continue; }
+        tok.push_back((char)std::tolower((unsigned char)c));
+    }
+    flush();
+
+    return mask ? mask : (unsigned)kTopicAll;
+}
+
+const char* EventStreamHub::EventName(unsigned topic)
+{
+    switch (topic) {
+    case kTopicChat: return "chat";
+    case kTopicAlerts: return "alert";
+    case kTopicMetrics: return "metrics";
+    default: return "message";
+    }
+}
+
+std::string EventStreamHub::FormatFrame(std::uint64_t id, const char* event, const nlohmann::json& data)
+{
+    // dump() without indent never emits raw newlines, so a single data: line is enough.
+    std::string s;
+    if (id) {
+        s += "id: ";
+        s += std::to_string(id);
+        s += "\n";
+    }
+    s += "event: ";
+    s += event;
+    s += "\ndata: ";
+    s += data.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    s += "\n\n";
+    return s;
+}
+
+void EventStreamHub::Publish(unsigned topic, const nlohmann::json& payload)
+{
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        if (connections_ == 0) {
+            // Nobody listening: keep the sequence moving but skip serialization.
+            ++next_seq_;
+            ring_.clear();
+            return;
+        }
+    }
+
+    PublishRaw(topic, payload.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace));
+}
+
+void EventStreamHub::PublishRaw(unsigned topic, const std::string& json_text)
+{
+    const char* event = EventName(topic);
+
+    std::lock_guard<std::mutex> lock(mu_);
+    if (connections_ == 0) {
+        ++next_seq_;
+        ring_.clear();
+        return;
+    }
+
+    Frame f;
+    f.seq = next_seq_++;
+    f.topic = topic;
+
+    const std::string id = std::to_string(f.seq);
+    f.text.reserve(json_text.size() + id.size() + 32);
+    f.text += "id: ";
+    f.text += id;
+    f.text += "\nevent: ";
+    f.text += event;
+    f.text += "\ndata: ";
+    f.text += json_text;
+    f.text += "\n\n";
+
+    while (ring_.size() >= capacity_) ring_.pop_front();
+    ring_.push_back(std::move(f));
+
+    cv_.notify_all();
+}
+
+bool EventStreamHub::WaitFrames(std::uint64_t& after_seq, unsigned topics, std::chrono::milliseconds timeout, std::string& out)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    std::unique_lock<std::mutex> lock(mu_);
+    for (;;) {
+        if (stopped_) return false;
+
+        const std::uint64_t latest = next_seq_ - 1;
+        if (after_seq > latest) {
+            // Last-Event-ID from a previous run of the app.
+            after_seq = latest;
+        }
+
+        if (after_seq < latest) {
+            std::size_t idx = 0;
+            if (ring_.empty() || after_seq + 1 < ring_.front().seq) {
+                // Fell behind the replay ring; the client should refetch via the REST endpoints.
+                out += FormatFrame(0, "resync", nlohmann::json::object());
+            }
+            else {
+                idx = (std::size_t)(after_seq + 1 - ring_.front().seq);
+            }
+
+            for (; idx < ring_.size(); ++idx) {
+                if (ring_[idx].topic & topics) out += ring_[idx].text;
+            }
+            after_seq = latest;
+            if (!out.empty()) return true;
+        }
+
+        if (cv_.wait_until(lock, deadline) == std::cv_status::timeout) {
+            return !stopped_;
+        }
+    }
+}
+
+std::uint64_t EventStreamHub::LatestSeq() const
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    return next_seq_ - 1;
+}
+
+void EventStreamHub::Start()
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    stopped_ = false;
+}
+
+void EventStreamHub::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stopped_ = true;
+    }
+    cv_.notify_all();
+}
+
+std::size_t EventStreamHub::Connections() const
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    return connections_;
+}
+
+void EventStreamHub::OnConnect()
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    ++connections_;
+}
+
+void EventStreamHub::OnDisconnect()
+{
+    std::lock_guard<std::mutex> lock(mu_);
+    if (connections_ > 0) --connections_;
+}
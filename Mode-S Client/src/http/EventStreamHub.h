@@ -0,0 +1,72 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+
+#include "json.hpp"
+
+// Fan-out hub behind the /api/stream Server-Sent Events endpoint.
+// Producers Publish() payloads under a topic; each SSE connection waits for frames newer
+// than its cursor. Frames are serialized once and kept in a small replay ring so a
+// reconnecting EventSource can resume via Last-Event-ID.
+class EventStreamHub {
+public:
+    // Topic bits used for per-connection filtering (?topics=chat,alerts,metrics).
+    enum Topic : unsigned {
+        kTopicChat = 1u << 0,
+        kTopicAlerts = 1u << 1,
+        kTopicMetrics = 1u << 2,
+        kTopicAll = kTopicChat | kTopicAlerts | kTopicMetrics
+    };
+
+    explicit EventStreamHub(std::size_t replay_capacity = 512);
+
+    // Parses a comma separated topic list. Empty or unknown-only input selects all topics.
+    static unsigned ParseTopics(const std::string& csv);
+
+    // Formats a single SSE frame. id == 0 omits the id line (not resumable).
+    static std::string FormatFrame(std::uint64_t id, const char* event, const nlohmann::json& data);
+
+    // Serializes the payload once and wakes waiting connections. Safe to call from any thread.
+    void Publish(unsigned topic, const nlohmann::json& payload);
+
+    // Same as Publish for an already serialized compact JSON value (must not contain raw newlines).
+    void PublishRaw(unsigned topic, const std::string& json_text);
+
+    // Blocks until frames with seq > after_seq matching `topics` exist, the timeout elapses,
+    // or the hub is stopped. Matching frames are appended to `out` and after_seq is advanced.
+    // Returns false once the hub is stopped (connection should close).
+    bool WaitFrames(std::uint64_t& after_seq, unsigned topics, std::chrono::milliseconds timeout, std::string& out);
+
+    std::uint64_t LatestSeq() const;
+
+    // Start() re-arms the hub; Stop() wakes every waiting connection so the HTTP pool can drain.
+    void Start();
+    void Stop();
+
+    // Number of currently attached SSE connections (diagnostics).
+    std::size_t Connections() const;
+    void OnConnect();
+    void OnDisconnect();
+
+private:
+    struct Frame {
+        std::uint64_t seq = 0;
+        unsigned topic = 0;
+        std::string text;
+    };
+
+    static const char* EventName(unsigned topic);
+
+    std::size_t capacity_;
+    mutable std::mutex mu_;
+    std::condition_variable cv_;
+    std::deque<Frame> ring_;
+    std::uint64_t next_seq_ = 1;
+    bool stopped_ = false;
+    std::size_t connections_ = 0;
+};
@@ -0,0 +1,312 @@
+#include "http/GzipEncoder.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+    constexpr int kWindowBits = 15;
+    constexpr std::size_t kWindowSize = (std::size_t)1 << kWindowBits;
+    constexpr std::size_t kWindowMask = kWindowSize - 1;
+    constexpr int kHashBits = 15;
+    constexpr std::uint32_t kHashSize = 1u << kHashBits;
+    constexpr int kMinMatch = 3;
+    constexpr int kMaxMatch = 258;
+    constexpr int kMaxChain = 32;     // candidates examined per position
+    constexpr int kGoodEnough = 128;  // stop searching once a match this long is found
+
+    struct Crc32Table {
+        std::uint32_t v[256];
+        Crc32Table() {
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                std::uint32_t c = i;
+                for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                v[i] = c;
+            }
+        }
+    };
+
+    std::uint32_t Crc32(const unsigned char* p, std::size_t n)
+    {
+        static const Crc32Table table;
+        std::uint32_t c = 0xFFFFFFFFu;
+        for (std::size_t i = 0; i < n; ++i) c = table.v[(c ^ p[i]) & 0xFF] ^ (c >> 8);
+        return c ^ 0xFFFFFFFFu;
+    }
+
+    std::uint32_t Reverse(std::uint32_t code, int len)
+    {
+        std::uint32_t r = 0;
+        for (int i = 0; i < len; ++i) {
+            r = (r << 1) | (code & 1);
+            code >>= 1;
+        }
+        return r;
+    }
+
+    // Fixed literal/length code (RFC 1951 3.2.6), pre-reversed for LSB-first output.
+    struct FixedCodes {
+        std::uint16_t lit_code[288];
+        std::uint8_t lit_len[288];
+        std::uint8_t dist_code[30];
+        FixedCodes() {
+            for (int s = 0; s < 288; ++s) {
+                std::uint32_t code;
+                int len;
+                if (s < 144) { code = 0x30 + s; len = 8; }
+                else if (s < 256) { code = 0x190 + (s - 144); len = 9; }
+                else if (s < 280) { code = (std::uint32_t)(s - 256); len = 7; }
+                else { code = 0xC0 + (s - 280); len = 8; }
+                lit_code[s] = (std::uint16_t)Reverse(code, len);
+                lit_len[s] = (std::uint8_t)len;
+            }
+            for (int d = 0; d < 30; ++d) dist_code[d] = (std::uint8_t)Reverse((std::uint32_t)d, 5);
+        }
+    };
+
+    int FloorLog2(unsigned v)
+    {
+        int n = 0;
+        while (v >>= 1) ++n;
+        return n;
+    }
+
+    class BitWriter {
+    public:
+        explicit BitWriter(std::string& out) : out_(out) {}
+
+        void Put(std::uint32_t bits, int n) {
+            buf_ |= (std::uint64_t)bits << count_;
+            count_ += n;
+            while (count_ >= 8) {
+                out_.push_back((char)(buf_ & 0xFF));
+                buf_ >>= 8;
+                count_ -= 8;
+            }
+        }
+
+        void Flush() {
+            if (count_ > 0) out_.push_back((char)(buf_ & 0xFF));
+            buf_ = 0;
+            count_ = 0;
+        }
+
+    private:
+        std::string& out_;
+        std::uint64_t buf_ = 0;
+        int count_ = 0;
+    };
+
+    class Deflater {
+    public:
+        Deflater(const unsigned char* p, std::size_t n, std::string& out)
+            : p_(p), n_(n), bw_(out), head_(kHashSize, -1), prev_(kWindowSize, -1) {}
+
+        void Run() {
+            bw_.Put(1, 1); // BFINAL
+            bw_.Put(1, 2); // BTYPE = 01 (fixed Huffman)
+
+            std::size_t i = 0;
+            while (i < n_) {
+                int best_len = 0;
+                std::size_t best_dist = 0;
+                if (i + kMinMatch <= n_) {
+                    FindMatch(i, best_len, best_dist);
+                }
+
+                if (best_len >= kMinMatch) {
+                    EmitMatch(best_len, best_dist);
+                    const std::size_t end = i + (std::size_t)best_len;
+                    for (; i < end; ++i) Insert(i);
+                }
+                else {
+                    EmitLiteral(p_[i]);
+                    Insert(i);
+                    ++i;
+                }
+            }
+
+            EmitSymbol(256);
+            bw_.Flush();
+        }
+
+    private:
+        std::uint32_t Hash(std::size_t i) const {
+            const std::uint32_t v = (std::uint32_t)p_[i] << 16 | (std::uint32_t)p_[i + 1] << 8 | p_[i + 2];
+            return (v * 2654435761u) >> (32 - kHashBits);
+        }
+
+        void Insert(std::size_t i) {
+            if (i + kMinMatch > n_) return;
+            const std::uint32_t h = Hash(i);
+            prev_[i & kWindowMask] = head_[h];
+            head_[h] = (std::int64_t)i;
+        }
+
+        void FindMatch(std::size_t i, int& best_len, std::size_t& best_dist) const {
+            const int max_len = (int)std::min<std::size_t>((std::size_t)kMaxMatch, n_ - i);
+            std::int64_t cand = head_[Hash(i)];
+            for (int chain = 0; chain < kMaxChain && cand >= 0; ++chain) {
+                const std::size_t c = (std::size_t)cand;
+                if (i - c > kWindowSize - 1) break;
+
+                if (p_[c + (std::size_t)best_len] == p_[i + (std::size_t)best_len] || best_len == 0) {
+                    int len = 0;
+                    while (len < max_len && p_[c + (std::size_t)len] == p_[i + (std::size_t)len]) ++len;
+                    if (len > best_len) {
+                        best_len = len;
+                        best_dist = i - c;
+                        if (len >= kGoodEnough || len == max_len) break;
+                    }
+                }
+
+                const std::int64_t next = prev_[c & kWindowMask];
+                if (next >= cand) break; // slot was overwritten by a newer position
+                cand = next;
+            }
+        }
+
+        void EmitSymbol(int sym) {
+            bw_.Put(codes_.lit_code[sym], codes_.lit_len[sym]);
+        }
+
+        void EmitLiteral(unsigned char b) { EmitSymbol(b); }
+
+        void EmitMatch(int len, std::size_t dist) {
+            // Length: codes 257..285 with 0..5 extra bits.
+            const unsigned l = (unsigned)(len - kMinMatch);
+            if (len == kMaxMatch) {
+                EmitSymbol(285);
+            }
+            else if (l < 8) {
+                EmitSymbol(257 + (int)l);
+            }
+            else {
+                const int n = FloorLog2(l);
+                const int extra = n - 2;
+                EmitSymbol(257 + 4 * (n - 1) + (int)((l >> extra) & 3));
+                bw_.Put(l & ((1u << extra) - 1), extra);
+            }
+
+            // Distance: codes 0..29 with 0..13 extra bits.
+            const unsigned d = (unsigned)(dist - 1);
+            if (d < 4) {
+                bw_.Put(codes_.dist_code[d], 5);
+            }
+            else {
+                const int n = FloorLog2(d);
+                const int extra = n - 1;
+                bw_.Put(codes_.dist_code[2 * n + (int)((d >> extra) & 1)], 5);
+                bw_.Put(d & ((1u << extra) - 1), extra);
+            }
+        }
+
+        static const FixedCodes codes_;
+
+        const unsigned char* p_;
+        std::size_t n_;
+        BitWriter bw_;
+        std::vector<std::int64_t> head_;
+        std::vector<std::int64_t> prev_;
+    };
+
+    const FixedCodes Deflater::codes_;
+
+    void PutLE32(std::string& out, std::uint32_t v)
+    {
+        for (int i = 0; i < 4; ++i) out.push_back((char)((v >> (8 * i)) & 0xFF));
+    }
+
+    bool EqualsNoCase(const std::string& s, std::size_t b, std::size_t e, const char* lit)
+    {
+        std::size_t i = 0;
+        for (; lit[i]; ++i) {
+            if (b + i >= e) return false;
+            if (std::tolower((unsigned char)s[b + i]) != lit[i]) return false;
+        }
+        return b + i == e;
+    }
+
+} // namespace
+
+namespace gzip {
+
+    std::string Compress(const char* data, std::size_t size)
+    {
+        const auto* p = reinterpret_cast<const unsigned char*>(data);
+
+        std::string out;
+        out.reserve(size / 3 + 64);
+
+        // Header: magic, CM=deflate, no flags, no mtime, XFL=0, OS=unknown.
+        static const unsigned char kHeader[10] = { 0x1f, 0x8b, 0x08, 0, 0, 0, 0, 0, 0, 0xff };
+        out.append(reinterpret_cast<const char*>(kHeader), sizeof(kHeader));
+
+        Deflater(p, size, out).Run();
+
+        PutLE32(out, Crc32(p, size));
+        PutLE32(out, (std::uint32_t)size);
+        return out;
+    }
+
+    bool AcceptsGzip(const std::string& accept_encoding)
+    {
+        // Explicit gzip entry wins over "*".
+        int gzip_q = -1;
+        int star_q = -1;
+
+        std::size_t start = 0;
+        while (start < accept_encoding.size()) {
+            std::size_t comma = accept_encoding.find(',', start);
+            if (comma == std::string::npos) comma = accept_encoding.size();
+
+            std::size_t semi = accept_encoding.find(';', start);
+            if (semi == std::string::npos || semi > comma) semi = comma;
+
+            std::size_t b = start;
+            std::size_t e = semi;
+            while (b < e && (accept_encoding[b] == ' ' || accept_encoding[b] == '\t')) ++b;
+            while (e > b && (accept_encoding[e - 1] == ' ' || accept_encoding[e - 1] == '\t')) --e;
+
+            // q=0 (or 0.0, 0.000) disables the coding; any other weight enables it.
+            int q = 1;
+            const std::size_t qpos = accept_encoding.find("q=", semi);
+            if (qpos != std::string::npos && qpos < comma) {
+                q = std::strtod(accept_encoding.c_str() + qpos + 2, nullptr) > 0.0 ? 1 : 0;
+            }
+
+            if (EqualsNoCase(accept_encoding, b, e, "gzip") || EqualsNoCase(accept_encoding, b, e, "x-gzip")) {
+                gzip_q = q;
+            }
+            else if (e - b == 1 && accept_encoding[b] == '*') {
+                star_q = q;
+            }
+
+            start = comma + 1;
+        }
+
+        if (gzip_q >= 0) return gzip_q > 0;
+        return star_q > 0;
+    }
+
+    bool IsCompressibleType(const std::string& content_type)
+    {
+        std::string t;
+        t.reserve(content_type.size());
+        for (char c : content_type) {
+            if (c == ';') break;
+            t.push_back((char)std::tolower((unsigned char)c));
+        }
+        while (!t.empty() && t.back() == ' ') t.pop_back();
+
+        if (t.compare(0, 5, "text/") == 0) return t != "text/event-stream";
+        return t == "application/json" ||
+            t == "application/javascript" ||
+            t == "application/xml" ||
+            t == "image/svg+xml";
+    }
+
+} // namespace gzip
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+// Minimal gzip (RFC 1952 / DEFLATE RFC 1951) encoder for HTTP responses.
+//
+// The build has no zlib, so this is a small single-pass compressor: LZ77 over a 32 KB window
+// with a bounded hash chain, emitted as one fixed-Huffman block. It trades a few percent of
+// ratio against zlib's dynamic trees for having no dependency; JSON and HTML still shrink to
+// roughly a quarter. Output is a complete gzip member any browser can decode.
+namespace gzip {
+
+    std::string Compress(const char* data, std::size_t size);
+    inline std::string Compress(const std::string& s) { return Compress(s.data(), s.size()); }
+
+    // True when an Accept-Encoding header value allows gzip (honours "gzip;q=0" and "*").
+    bool AcceptsGzip(const std::string& accept_encoding);
+
+    // Text-like content types worth compressing (JSON, HTML, JS, CSS, SVG, plain text).
+    bool IsCompressibleType(const std::string& content_type);
+
+} // namespace gzip
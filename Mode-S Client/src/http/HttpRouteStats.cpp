@@ -0,0 +1,56 @@
+#include "http/HttpRouteStats.h"
+
+void HttpRouteStats::Record(const std::string& route, int status, std::size_t raw_bytes, std::size_t sent_bytes, bool gzip)
+{
+    std::lock_guard<std::mutex> lock(mu_);
+
+    auto it = routes_.find(route);
+    if (it == routes_.end()) {
+        it = routes_.emplace(routes_.size() < kMaxRoutes ? route : std::string("(other)"), Route{}).first;
+    }
+
+    Route& r = it->second;
+    ++r.requests;
+    if (status == 304) ++r.not_modified;
+    if (gzip) ++r.gzip;
+    r.raw_bytes += raw_bytes;
+    r.sent_bytes += sent_bytes;
+    r.last_content_length = sent_bytes;
+    if (sent_bytes > r.max_content_length) r.max_content_length = sent_bytes;
+}
+
+nlohmann::json HttpRouteStats::Json() const
+{
+    auto ratio = [](std::uint64_t sent, std::uint64_t raw) {
+        return raw ? (double)sent / (double)raw : 1.0;
+    };
+
+    nlohmann::json routes = nlohmann::json::object();
+    std::uint64_t total_requests = 0, total_raw = 0, total_sent = 0;
+
+    std::lock_guard<std::mutex> lock(mu_);
+    for (const auto& kv : routes_) {
+        const Route& r = kv.second;
+        routes[kv.first] = {
+            {"requests", r.requests},
+            {"not_modified", r.not_modified},
+            {"gzip", r.gzip},
+            {"raw_bytes", r.raw_bytes},
+            {"sent_bytes", r.sent_bytes},
+            {"last_content_length", r.last_content_length},
+            {"max_content_length", r.max_content_length},
+            {"ratio", ratio(r.sent_bytes, r.raw_bytes)},
+        };
+        total_requests += r.requests;
+        total_raw += r.raw_bytes;
+        total_sent += r.sent_bytes;
+    }
+
+    return {
+        {"routes", std::move(routes)},
+        {"requests", total_requests},
+        {"raw_bytes", total_raw},
+        {"sent_bytes", total_sent},
+        {"ratio", ratio(total_sent, total_raw)},
+    };
+}
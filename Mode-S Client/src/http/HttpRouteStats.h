@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "json.hpp"
+
+// Per-route response counters for /api/http/stats: request count, bytes before and after
+// Content-Encoding, and the resulting compression ratio. Keyed by the matched route pattern,
+// so the key set is bounded by the registered routes.
+class HttpRouteStats {
+public:
+    // `raw_bytes` is the body size before compression, `sent_bytes` the Content-Length written.
+    void Record(const std::string& route, int status, std::size_t raw_bytes, std::size_t sent_bytes, bool gzip);
+
+    nlohmann::json Json() const;
+
+private:
+    struct Route {
+        std::uint64_t requests = 0;
+        std::uint64_t not_modified = 0; // 304s
+        std::uint64_t gzip = 0;         // responses sent gzip-encoded
+        std::uint64_t raw_bytes = 0;
+        std::uint64_t sent_bytes = 0;
+        std::uint64_t last_content_length = 0;
+        std::uint64_t max_content_length = 0;
+    };
+
+    // Unmatched paths all land in "(unmatched)"; this only guards against surprises.
+    static constexpr std::size_t kMaxRoutes = 256;
+
+    mutable std::mutex mu_;
+    std::map<std::string, Route> routes_;
+};
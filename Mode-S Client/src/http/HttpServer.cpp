@@ -1,5 +1,7 @@
 #include "HttpServer.h"
+#include "GzipEncoder.h"
 #include "log/UiLog.h"
+#include "core/ConfigWriteBehind.h"
 #include "core/StringUtil.h"
 #include <Windows.h>
 #include <shellapi.h>
@@ -8,6 +10,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <chrono>
 #include <thread>
 
@@ -394,14 +397,6 @@ static std::string Trim(const std::string& s) {
     return s.substr(a, b - a);
 }
 
-static std::string ReadFileUtf8(const std::filesystem::path& p) {
-    std::ifstream f(p, std::ios::binary);
-    if (!f) return {};
-    std::ostringstream ss;
-    ss << f.rdbuf();
-    return ss.str();
-}
-
 static const char* ContentTypeFor(const std::string& path) {
     auto dot = path.find_last_of('.');
     std::string ext = (dot == std::string::npos) ? "" : path.substr(dot + 1);
@@ -452,15 +447,37 @@ HttpServer::~HttpServer() {
 void HttpServer::Start() {
     if (svr_) return;
 
+    // Each /api/stream client holds a worker for the lifetime of its connection,
+    // so size the pool above httplib's default to leave room for regular requests.
+    constexpr size_t kHttpWorkerThreads = 32;
+
     svr_ = std::make_unique<httplib::Server>();
+    svr_->new_task_queue = [] { return new httplib::ThreadPool(kHttpWorkerThreads); };
+    svr_->set_post_routing_handler([this](const httplib::Request& req, httplib::Response& res) {
+        FinishResponse(req, res);
+    });
     RegisterRoutes();
 
+    // Start SSE pump before listening so the first /api/stream client sees live data.
+    StartStreamPump();
+
     // Start SimBrief cache worker (safe even if it fails; endpoint will still respond).
     StartSimBriefWorker();
 
     // Start SimConnect worker (safe even if MSFS isn't running; it will keep retrying).
     StartSimConnectWorker();
 
+    // Supporter feed refresher (idle until an overlay polls /api/supporters/recent).
+    supporters_ = std::make_unique<supporter::SupporterFeedService>(
+        state_,
+        config_.twitch_login,
+        opt_.twitch_get_access_token,
+        opt_.twitch_get_client_id,
+        opt_.youtube_get_access_token,
+        opt_.youtube_get_channel_id,
+        log_);
+    supporters_->Start();
+
     thread_ = std::thread([this]() {
         try {
             HttpLog(log_, L"Listening on http://" + ToW(opt_.bind_host) + L":" + std::to_wstring(opt_.port));
@@ -480,6 +497,10 @@ void HttpServer::Stop() {
 
     StopSimBriefWorker();
     StopSimConnectWorker();
+    if (supporters_) supporters_->Stop();
+
+    // Release SSE connections first; otherwise their workers block the pool shutdown.
+    StopStreamPump();
     try {
         svr_->stop();
     }
@@ -655,6 +676,224 @@ void HttpServer::StopSimConnectWorker() {
     simconnect_.reset();
 }
 
+void HttpServer::StartStreamPump() {
+    if (stream_thread_.joinable()) return;
+
+    stream_stop_.store(false);
+    {
+        std::lock_guard<std::mutex> lk(stream_mu_);
+        stream_chat_dirty_ = false;
+    }
+    stream_.Start();
+
+    // Chat: the ingest thread only flags new data; the pump pulls by cursor so
+    // pushed items carry the same seq/id as /api/chat responses.
+    ChatAggregator::SubscribeOptions sub_opts;
+    sub_opts.name = "http-stream";
+    sub_opts.queue_capacity = 64; // only used as a wake-up signal
+    stream_chat_sub_id_ = chat_.Subscribe([this](const ChatMessage&) {
+        {
+            std::lock_guard<std::mutex> lk(stream_mu_);
+            stream_chat_dirty_ = true;
+        }
+        stream_cv_.notify_one();
+        }, sub_opts);
+
+    stream_support_sub_id_ = state_.subscribe_support_events("http-stream", [this](const SupportEvent& ev) {
+        stream_.Publish(EventStreamHub::kTopicAlerts, *ev.payload);
+        });
+
+    stream_thread_ = std::thread([this]() {
+        constexpr auto kMetricsInterval = std::chrono::milliseconds(250);
+
+        std::uint64_t chat_cursor = chat_.LatestSeq();
+        nlohmann::json last_metrics = nlohmann::json::object();
+        std::string last_metrics_version;
+        auto next_metrics = std::chrono::steady_clock::now();
+
+        while (!stream_stop_.load()) {
+            bool chat_dirty = false;
+            {
+                std::unique_lock<std::mutex> lk(stream_mu_);
+                stream_cv_.wait_until(lk, next_metrics, [this]() {
+                    return stream_chat_dirty_ || stream_stop_.load();
+                    });
+                chat_dirty = stream_chat_dirty_;
+                stream_chat_dirty_ = false;
+            }
+            if (stream_stop_.load()) break;
+
+            try {
+                const bool has_clients = stream_.Connections() > 0;
+
+                if (chat_dirty) {
+                    if (has_clients) {
+                        // Drain the whole backlog: the dirty flag is already consumed, so
+                        // anything left here would wait for the next unrelated message.
+                        constexpr int kChatBatch = 200;
+                        for (;;) {
+                            const auto frags = chat_.RecentFragments(chat_cursor, kChatBatch, &chat_cursor);
+                            for (const auto& f : frags) {
+                                stream_.PublishRaw(EventStreamHub::kTopicChat, f);
+                            }
+                            if ((int)frags.size() < kChatBatch || stream_stop_.load()) break;
+                        }
+                    }
+                    else {
+                        chat_cursor = chat_.LatestSeq();
+                    }
+                }
+
+                const auto now = std::chrono::steady_clock::now();
+                if (now >= next_metrics) {
+                    next_metrics = now + kMetricsInterval;
+                    std::string version = MetricsVersion();
+                    if (has_clients && version != last_metrics_version) {
+                        last_metrics_version = std::move(version);
+                        nlohmann::json cur = MetricsSnapshotJson();
+                        nlohmann::json delta = nlohmann::json::object();
+                        for (auto it = cur.begin(); it != cur.end(); ++it) {
+                            auto prev = last_metrics.find(it.key());
+                            if (prev == last_metrics.end() || *prev != it.value()) {
+                                delta[it.key()] = it.value();
+                            }
+                        }
+                        if (!delta.empty()) {
+                            stream_.Publish(EventStreamHub::kTopicMetrics, delta);
+                        }
+                        last_metrics = std::move(cur);
+                    }
+                }
+            }
+            catch (...) {
+                // Best-effort: a bad payload must not kill the pump.
+            }
+        }
+        });
+}
+
+void HttpServer::StopStreamPump() {
+    if (stream_chat_sub_id_) {
+        chat_.Unsubscribe(stream_chat_sub_id_);
+        stream_chat_sub_id_ = 0;
+    }
+    if (stream_support_sub_id_) {
+        state_.unsubscribe_support_events(stream_support_sub_id_);
+        stream_support_sub_id_ = 0;
+    }
+
+    stream_.Stop();
+
+    stream_stop_.store(true);
+    stream_cv_.notify_all();
+    if (stream_thread_.joinable()) {
+        if (std::this_thread::get_id() == stream_thread_.get_id()) {
+            stream_thread_.detach();
+        }
+        else {
+            stream_thread_.join();
+        }
+    }
+}
+
+std::string HttpServer::MetricsVersion() const {
+    const uint64_t now_ms = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+
+    euroscope_.Expire();
+
+    // euroscope_connected depends on the clock, so it is part of the version.
+    return std::to_string(state_.version(AppState::Domain::Metrics)) + "." +
+        std::to_string(euroscope_.Version()) + "." +
+        (euroscope_.Connected(now_ms) ? "1" : "0");
+}
+
+nlohmann::json HttpServer::MetricsSnapshotJson() const {
+    auto j = state_.metrics_json();
+
+    const uint64_t now_ms = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+
+    // Merge EuroScope ingest snapshot into the metrics payload
+    j.update(euroscope_.Metrics(now_ms));
+    return j;
+}
+
+// Gzip copy of the body the current handler just set from a cache, handed to FinishResponse()
+// (httplib runs routing and the post-routing hook on the same worker thread).
+static thread_local std::shared_ptr<const std::string> t_gzip_body;
+
+void HttpServer::ServeCachedJson(const httplib::Request& req, httplib::Response& res,
+                                 const std::string& key, const std::string& version,
+                                 const std::function<std::string()>& build, bool store) {
+    const std::string etag = response_cache_.ETag(key, version);
+
+    // "no-cache" (not "no-store") so browsers keep the body and revalidate with If-None-Match.
+    res.set_header("ETag", etag);
+    res.set_header("Cache-Control", "no-cache");
+
+    if (req.has_header("If-None-Match") &&
+        ResponseCache::IfNoneMatch(req.get_header_value("If-None-Match"), etag)) {
+        res.status = 304;
+        return;
+    }
+
+    if (!store) {
+        res.set_content(build(), "application/json; charset=utf-8");
+        return;
+    }
+
+    auto body = response_cache_.Get(key, version, build);
+    res.set_content(body->bytes, "application/json; charset=utf-8");
+    if (!body->gzip.empty()) t_gzip_body = std::shared_ptr<const std::string>(body, &body->gzip);
+}
+
+void HttpServer::FinishResponse(const httplib::Request& req, httplib::Response& res) {
+    // Always consume the hand-off so it never leaks into the next request on this thread.
+    std::shared_ptr<const std::string> cached_gzip = std::move(t_gzip_body);
+    t_gzip_body.reset();
+
+    const std::size_t raw_bytes = res.body.size();
+    bool gzipped = false;
+
+    try {
+        // Empty bodies cover 304s and streamed (content provider) responses such as /api/stream.
+        if (res.status == 200 && !res.body.empty() && !res.has_header("Content-Encoding") &&
+            (cached_gzip || raw_bytes >= kGzipMinBytes) &&
+            gzip::IsCompressibleType(res.get_header_value("Content-Type"))) {
+            res.set_header("Vary", "Accept-Encoding");
+
+            if (gzip::AcceptsGzip(req.get_header_value("Accept-Encoding"))) {
+                std::string z = cached_gzip ? *cached_gzip : gzip::Compress(res.body);
+                if (z.size() < raw_bytes) {
+                    res.body.swap(z);
+                    res.set_header("Content-Encoding", "gzip");
+
+                    // httplib already set Content-Length for the raw body.
+                    res.headers.erase("Content-Length");
+                    res.set_header("Content-Length", std::to_string(res.body.size()));
+
+                    // Same ETag for both encodings would be a strong-validator lie; weaken it
+                    // like nginx does. IfNoneMatch() ignores the W/ prefix on the way back in.
+                    auto etag = res.headers.find("ETag");
+                    if (etag != res.headers.end() && etag->second.compare(0, 2, "W/") != 0) {
+                        etag->second = "W/" + etag->second;
+                    }
+                    gzipped = true;
+                }
+            }
+        }
+    }
+    catch (...) {
+        // Compression is best-effort; the raw body is still intact.
+    }
+
+    route_stats_.Record(req.matched_route.empty() ? std::string("(unmatched)") : req.matched_route,
+        res.status, raw_bytes, res.body.size(), gzipped);
+}
+
 // Inserts `insert` right after the first occurrence of `needle`.
 // Returns true if inserted.
 static bool InsertAfterFirst(std::string& s, const std::string& needle, const std::string& insert)
@@ -739,6 +978,46 @@ void HttpServer::ApplyOverlayTokens(std::string& html)
     }
 }
 
+std::string HttpServer::OverlayTokenVariant() const
+{
+    // The font stack is fixed (Inter) in ApplyOverlayTokens, so overlay_font_family is not an input.
+    return std::to_string(state_.version(AppState::Domain::OverlayHeader)) + "|" +
+        (config_.overlay_text_shadow ? "1" : "0");
+}
+
+bool HttpServer::ServeStaticFile(const httplib::Request& req, httplib::Response& res,
+                                 const std::filesystem::path& path, const std::string& rel)
+{
+    const bool is_html = rel.size() >= 5 && rel.substr(rel.size() - 5) == ".html";
+
+    const bool compress = gzip::IsCompressibleType(ContentTypeFor(rel));
+
+    std::shared_ptr<const StaticAssetCache::Asset> asset;
+    if (is_html) {
+        asset = static_cache_.Get(path, OverlayTokenVariant(), [this](std::string& html) {
+            ApplyOverlayTokens(html);
+        }, compress);
+    }
+    else {
+        asset = static_cache_.Get(path, std::string(), nullptr, compress);
+    }
+    if (!asset) return false;
+
+    // Revalidate every time (edits on disk and header changes show up immediately), but let
+    // unchanged files come back as a bodiless 304.
+    res.set_header("ETag", asset->etag);
+    res.set_header("Cache-Control", "no-cache");
+    if (req.has_header("If-None-Match") &&
+        ResponseCache::IfNoneMatch(req.get_header_value("If-None-Match"), asset->etag)) {
+        res.status = 304;
+        return true;
+    }
+
+    res.set_content(asset->bytes, ContentTypeFor(rel));
+    if (!asset->gzip.empty()) t_gzip_body = std::shared_ptr<const std::string>(asset, &asset->gzip);
+    return true;
+}
+
 void HttpServer::RegisterRoutes() {
     auto& svr = *svr_;
 
@@ -761,44 +1040,108 @@ void HttpServer::RegisterRoutes() {
         });
 
     // --- API: metrics ---
-    svr.Get("/api/metrics", [&](const httplib::Request&, httplib::Response& res) {
-        auto j = state_.metrics_json();
+    svr.Get("/api/metrics", [&](const httplib::Request& req, httplib::Response& res) {
+        ServeCachedJson(req, res, "metrics", MetricsVersion(), [this]() {
+            return MetricsSnapshotJson().dump(2);
+        });
+        });
 
-        const uint64_t now_ms = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-        ).count();
+    // --- API: per-route response sizes (bytes before/after gzip, compression ratio) ---
+    svr.Get("/api/http/stats", [&](const httplib::Request&, httplib::Response& res) {
+        json out = route_stats_.Json();
+        out["ok"] = true;
+        out["gzip_min_bytes"] = kGzipMinBytes;
+        res.set_header("Cache-Control", "no-store");
+        res.set_content(out.dump(2), "application/json; charset=utf-8");
+        });
 
-        // Merge EuroScope ingest snapshot into the metrics payload
-        j.update(euroscope_.Metrics(now_ms));
+    // --- API: AppState lock contention per domain (acquisitions / contended / wait time) ---
+    svr.Get("/api/state/locks", [&](const httplib::Request&, httplib::Response& res) {
+        json out;
+        out["ok"] = true;
+        out["locks"] = state_.lock_stats_json();
+        res.set_header("Cache-Control", "no-store");
+        res.set_content(out.dump(2), "application/json; charset=utf-8");
+        });
 
-        res.set_content(j.dump(2), "application/json; charset=utf-8");
+    // --- API: config.json write-behind (patches coalesced, flush latency, bytes written) ---
+    svr.Get("/api/config/persistence", [&](const httplib::Request&, httplib::Response& res) {
+        json out;
+        out["ok"] = true;
+        out["config_writer"] = SharedConfigWriter().StatsJson();
+        res.set_header("Cache-Control", "no-store");
+        res.set_content(out.dump(2), "application/json; charset=utf-8");
+        });
+
+    // --- API: live push stream (Server-Sent Events) ---
+    // GET /api/stream?topics=chat,alerts,metrics   (default: all topics)
+    // Events: "chat" (same item shape as /api/chat), "alert" (EventSub/TikTok/YouTube payload),
+    // "metrics" (changed /api/metrics keys only; the first frame is a full snapshot),
+    // "resync" (client fell behind the replay ring and should refetch via REST).
+    // Reconnecting EventSource clients resume via the Last-Event-ID header.
+    svr.Get("/api/stream", [&](const httplib::Request& req, httplib::Response& res) {
+        const unsigned topics = EventStreamHub::ParseTopics(
+            req.has_param("topics") ? req.get_param_value("topics") : std::string{});
+
+        auto cursor = std::make_shared<std::uint64_t>(stream_.LatestSeq());
+        if (req.has_header("Last-Event-ID")) {
+            try { *cursor = std::stoull(req.get_header_value("Last-Event-ID")); }
+            catch (...) {}
+        }
+        auto first = std::make_shared<bool>(true);
+
+        res.set_header("Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
+        res.set_header("Pragma", "no-cache");
+
+        stream_.OnConnect();
+        res.set_chunked_content_provider(
+            "text/event-stream; charset=utf-8",
+            [this, topics, cursor, first](size_t, httplib::DataSink& sink) {
+                std::string out;
+                if (*first) {
+                    *first = false;
+                    out += "retry: 2000\n\n";
+                    if (topics & EventStreamHub::kTopicMetrics) {
+                        out += EventStreamHub::FormatFrame(0, "metrics", MetricsSnapshotJson());
+                    }
+                }
+                else if (!stream_.WaitFrames(*cursor, topics, std::chrono::seconds(15), out)) {
+                    return false; // server stopping
+                }
+
+                // Comment line keeps proxies/OBS from timing out an idle stream.
+                if (out.empty()) out = ": keep-alive\n\n";
+
+                if (!sink.is_writable()) return false;
+                return sink.write(out.data(), out.size());
+            },
+            [this](bool) { stream_.OnDisconnect(); });
         });
 
     // --- API: platform runtime status (requested state from homepage control surface) ---
-    svr.Get("/api/platform/status", [&](const httplib::Request&, httplib::Response& res) {
-        auto j = state_.platform_runtime_state_json();
-        res.set_content(j.dump(2), "application/json; charset=utf-8");
+    svr.Get("/api/platform/status", [&](const httplib::Request& req, httplib::Response& res) {
+        ServeCachedJson(req, res, "platform_status",
+            std::to_string(state_.version(AppState::Domain::PlatformStatus)), [this]() {
+                return state_.platform_runtime_state_json().dump(2);
+            });
         });
 
     svr.Get("/api/supporters/recent", [&](const httplib::Request& req, httplib::Response& res) {
-        int limit = 16;
+        int limit = supporter::SupporterFeedService::kDefaultLimit;
         if (req.has_param("limit")) {
             try { limit = std::stoi(req.get_param_value("limit")); }
-            catch (...) { limit = 16; }
+            catch (...) { limit = supporter::SupporterFeedService::kDefaultLimit; }
         }
+        // Missing, invalid or non-positive limit -> kDefaultLimit (16); capped at kMaxLimit (100).
+        if (limit <= 0) limit = supporter::SupporterFeedService::kDefaultLimit;
+        limit = (std::min)(limit, supporter::SupporterFeedService::kMaxLimit);
 
-        supporter::SupporterFeedService feed(
-            state_,
-            config_.twitch_login,
-            opt_.twitch_get_access_token,
-            opt_.twitch_get_client_id,
-            opt_.youtube_get_access_token,
-            opt_.youtube_get_channel_id,
-            log_);
-
-        const auto payload = supporter::ToJson(feed.FetchRecent(limit));
-        res.status = 200;
-        res.set_content(payload.dump(2), "application/json; charset=utf-8");
+        // Served from the refresher's cached list; a stale list is returned immediately and
+        // refreshed in the background.
+        const std::uint64_t generation = supporters_->Poll(limit);
+        ServeCachedJson(req, res, "supporters_recent?" + std::to_string(limit), std::to_string(generation), [this, limit]() {
+            return supporter::ToJson(supporters_->Recent(limit)).dump(2);
+        });
         });
 
     // --- API: SimBrief flight plan summary (for MSFS overlays) ---
@@ -1081,8 +1424,17 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
             try { limit = std::max(1, std::min(1000, std::stoi(req.get_param_value("limit")))); }
             catch (...) {}
         }
-        auto j = state_.twitch_eventsub_events_json(limit);
-        res.set_content(j.dump(2), "application/json; charset=utf-8");
+        std::uint64_t since = 0;
+        if (req.has_param("since")) {
+            try { since = (std::uint64_t)std::stoull(req.get_param_value("since")); }
+            catch (...) {}
+        }
+        const std::string query = std::to_string(since) + "," + std::to_string(limit);
+        // Each poller sends its own since= cursor: only the since=0 view is kept in the cache.
+        ServeCachedJson(req, res, "twitch_eventsub_events?" + query,
+            std::to_string(state_.version(AppState::Domain::TwitchEventSub)), [this, limit, since]() {
+                return state_.twitch_eventsub_events_json(limit, since).dump(2);
+            }, since == 0);
         });
 
 
@@ -1831,6 +2183,7 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
 
                     if (j.contains("tiktok_unique_id"))      config_.tiktok_unique_id = j.value("tiktok_unique_id", config_.tiktok_unique_id);
                     if (j.contains("twitch_login"))          config_.twitch_login = j.value("twitch_login", config_.twitch_login);
+                    if (j.contains("twitch_login") && supporters_) supporters_->SetTwitchLogin(config_.twitch_login);
                     if (j.contains("twitch_client_id"))      config_.twitch_client_id = j.value("twitch_client_id", config_.twitch_client_id);
                     if (j.contains("twitch_client_secret"))  config_.twitch_client_secret = j.value("twitch_client_secret", config_.twitch_client_secret);
                     if (j.contains("youtube_handle"))        config_.youtube_handle = j.value("youtube_handle", config_.youtube_handle);
@@ -2472,6 +2825,7 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
 
                 if (j.contains("twitch_login")) {
                     config_.twitch_login = j.value("twitch_login", config_.twitch_login);
+                    if (supporters_) supporters_->SetTwitchLogin(config_.twitch_login);
                 }
                 if (j.contains("twitch_client_id")) {
                     config_.twitch_client_id = j.value("twitch_client_id", config_.twitch_client_id);
@@ -2595,20 +2949,111 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
         });
 
     
-    // EuroScope traffic snapshot (derived from last ingest)
-    // Returns the "euroscope" object from /api/metrics as a standalone payload.
-    svr.Get("/api/euroscope/traffic", [&](const httplib::Request&, httplib::Response& res) {
-        const uint64_t now_ms = (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-        ).count();
+    // EuroScope traffic (sector summary + aircraft keyed by callsign, see EuroScopeTrafficStore).
+    // The body is kept serialized by the ingest service and only rebuilt after a change.
+    svr.Get("/api/euroscope/traffic", [&](const httplib::Request& req, httplib::Response& res) {
+        euroscope_.Expire();
+        ServeCachedJson(req, res, "euroscope_traffic", std::to_string(euroscope_.Version()), [this]() {
+            return euroscope_.TrafficJson();
+        });
+        });
+
+    // Aircraft near a point (default: the sector airport), nearest first, with distance_nm and
+    // bearing_deg. Served from the store's position grid. lat and lon go together; a malformed
+    // lat/lon, radius_nm or limit is a 400.
+    svr.Get("/api/euroscope/traffic/nearby", [&](const httplib::Request& req, httplib::Response& res) {
+        bool has_pos = false;
+        double lat = 0.0;
+        double lon = 0.0;
+        double radius_nm = 50.0;
+        int limit = 50;
 
-        nlohmann::json j = euroscope_.Metrics(now_ms);
-        if (!j.is_object() || !j.contains("euroscope")) {
-            res.set_content(R"({"ts_ms":0,"error":"no euroscope data"})", "application/json; charset=utf-8");
+        auto bad_request = [&res](const char* error) {
+            res.status = 400;
+            res.set_content(std::string(R"({"ok":false,"error":")") + error + "\"}", "application/json; charset=utf-8");
+        };
+
+        if (req.has_param("lat") != req.has_param("lon")) {
+            bad_request("lat and lon must be given together");
+            return;
+        }
+        if (req.has_param("lat")) {
+            try {
+                lat = std::stod(req.get_param_value("lat"));
+                lon = std::stod(req.get_param_value("lon"));
+                has_pos = std::isfinite(lat) && std::isfinite(lon) &&
+                    lat >= -90.0 && lat <= 90.0 && lon >= -180.0 && lon <= 180.0;
+            }
+            catch (...) {}
+            if (!has_pos) {
+                bad_request("invalid lat/lon");
+                return;
+            }
+        }
+        if (req.has_param("radius_nm")) {
+            bool ok = false;
+            try {
+                radius_nm = std::stod(req.get_param_value("radius_nm"));
+                ok = std::isfinite(radius_nm) && radius_nm > 0.0;
+            }
+            catch (...) {}
+            if (!ok) {
+                bad_request("invalid radius_nm");
+                return;
+            }
+            radius_nm = std::max(0.1, std::min(3000.0, radius_nm));
+        }
+        if (req.has_param("limit")) {
+            bool ok = false;
+            try {
+                limit = std::stoi(req.get_param_value("limit"));
+                ok = limit > 0;
+            }
+            catch (...) {}
+            if (!ok) {
+                bad_request("invalid limit");
+                return;
+            }
+            limit = std::min(EuroScopeTrafficStore::kMaxNearby, limit);
+        }
+
+        if (!has_pos && !euroscope_.FieldPosition(lat, lon)) {
+            bad_request("lat/lon required: no airport position from EuroScope");
+            return;
+        }
+
+        // Only the airport-centred default is shared by every overlay; arbitrary coordinates get
+        // an ETag but are not kept, so they cannot push hot entries out of the cache.
+        euroscope_.Expire();
+        const std::string query = std::to_string(lat) + "," + std::to_string(lon) + "," +
+            std::to_string(radius_nm) + "," + std::to_string(limit);
+        ServeCachedJson(req, res, "euroscope_nearby?" + query, std::to_string(euroscope_.Version()),
+            [this, lat, lon, radius_nm, limit]() {
+                return euroscope_.NearbyJson(lat, lon, radius_nm, limit).dump();
+            }, !has_pos);
+        });
+
+    // Position history per callsign for trails/replay (see EuroScopeTrailStore). Poll with
+    // since_ms=<previous ts_ms> for new samples only; format=bin returns the binary layout.
+    svr.Get("/api/euroscope/trails", [&](const httplib::Request& req, httplib::Response& res) {
+        std::uint64_t since_ms = 0;
+        if (req.has_param("since_ms")) {
+            try { since_ms = (std::uint64_t)std::stoull(req.get_param_value("since_ms")); }
+            catch (...) {}
+        }
+
+        euroscope_.Expire();
+        if (req.has_param("format") && req.get_param_value("format") == "bin") {
+            res.set_header("Cache-Control", "no-cache");
+            res.set_content(euroscope_.TrailsBinary(since_ms), "application/octet-stream");
             return;
         }
 
-        res.set_content(j["euroscope"].dump(2), "application/json; charset=utf-8");
+        // Every poll carries a fresh since_ms cursor: only the full (since_ms=0) view is cached.
+        ServeCachedJson(req, res, "euroscope_trails?" + std::to_string(since_ms),
+            std::to_string(euroscope_.Version()), [this, since_ms]() {
+                return euroscope_.TrailsJson(since_ms).dump();
+            }, since_ms == 0);
         });
 
 
@@ -2652,10 +3097,11 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
             catch (...) {}
         }
 
-        auto j = state_.euroscope_tag_events_json(since, limit);
-        res.set_header("Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
-        res.set_header("Pragma", "no-cache");
-        res.set_content(j.dump(2), "application/json; charset=utf-8");
+        const std::string query = std::to_string(since) + "," + std::to_string(limit);
+        ServeCachedJson(req, res, "euroscope_tag_events?" + query,
+            std::to_string(state_.version(AppState::Domain::EuroScopeTagEvents)), [this, since, limit]() {
+                return state_.euroscope_tag_events_json(since, limit).dump(2);
+            });
         });
 
     svr.Post("/api/euroscope", [&](const httplib::Request& req, httplib::Response& res) {
@@ -2679,23 +3125,33 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
             catch (...) {}
         }
 
-        // Prefer aggregator as source of truth
-        json msgs = chat_.RecentJson(limit);
+        // Incremental mode: ?since=<seq> returns only messages newer than the cursor.
+        bool incremental = false;
+        std::uint64_t since_seq = 0;
+        if (req.has_param("since")) {
+            try { since_seq = std::stoull(req.get_param_value("since")); incremental = true; }
+            catch (...) {}
+        }
+
+        // Prefer aggregator as source of truth. Items are pre-serialized at Add() time,
+        // so the response is assembled by concatenation instead of building a JSON DOM.
+        std::uint64_t latest_seq = 0;
+        std::string msgs_text = incremental
+            ? chat_.RecentJsonText(since_seq, (size_t)limit, &latest_seq)
+            : chat_.RecentJsonText((size_t)limit, &latest_seq);
 
         // If aggregator is empty (adapters write into AppState), fall back to AppState chat JSON.
-        if (!msgs.is_array() || msgs.empty()) {
+        if (latest_seq == 0) {
             try {
                 json s = state_.chat_json();
                 // s is an array of chat messages (oldest->newest). Return only the last `limit` messages.
-                if (s.is_array()) {
+                if (s.is_array() && !s.empty()) {
                     if ((int)s.size() > limit) {
                         json slice = json::array();
                         for (size_t i = s.size() - limit; i < s.size(); ++i) slice.push_back(s[i]);
-                        msgs = std::move(slice);
-                    }
-                    else {
-                        msgs = std::move(s);
+                        s = std::move(slice);
                     }
+                    msgs_text = s.dump(-1, ' ', false, json::error_handler_t::replace);
                 }
             }
             catch (...) {
@@ -2703,18 +3159,43 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
             }
         }
 
-        json out;
-        out["ts_ms"] = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        const long long ts_ms = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now().time_since_epoch()
         ).count();
-        out["messages"] = std::move(msgs);
 
-        res.set_content(out.dump(2), "application/json; charset=utf-8");
+        std::string body;
+        body.reserve(msgs_text.size() + 80);
+        body += "{\"ts_ms\":";
+        body += std::to_string(ts_ms);
+        body += ",\"latest_seq\":";
+        body += std::to_string(latest_seq);
+        body += ",\"messages\":";
+        body += msgs_text;
+        body += "}";
+
+        res.set_content(std::move(body), "application/json; charset=utf-8");
         };
 
     svr.Get("/api/chat/recent", handle_chat_recent);
     svr.Get("/api/chat", handle_chat_recent);
 
+    // --- API: chat subscriber diagnostics (queue depth / drops / dispatch lag) ---
+    svr.Get("/api/chat/subscribers", [&](const httplib::Request&, httplib::Response& res) {
+        json out;
+        out["ok"] = true;
+        out["subscribers"] = chat_.SubscribersJson();
+        res.set_content(out.dump(2), "application/json; charset=utf-8");
+        });
+
+    // --- API: support event bus subscribers (delivered / failed per consumer) ---
+    svr.Get("/api/events/subscribers", [&](const httplib::Request&, httplib::Response& res) {
+        json out;
+        out["ok"] = true;
+        out["subscribers"] = state_.support_event_subscribers_json();
+        res.set_header("Cache-Control", "no-store");
+        res.set_content(out.dump(2), "application/json; charset=utf-8");
+        });
+
     // --- API: bot commands ---
     // GET  /api/bot/commands  -> current command list
     // POST /api/bot/commands  -> replace command list
@@ -2732,6 +3213,15 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
         res.set_content(out.dump(2), "application/json; charset=utf-8");
     });
 
+    // --- API: bot outbound queue (per-platform depth / failures / send latency) ---
+    svr.Get("/api/bot/outbound", [&](const httplib::Request&, httplib::Response& res) {
+        json out;
+        out["ok"] = true;
+        out["outbound"] = opt_.bot_reply_metrics_json ? opt_.bot_reply_metrics_json() : json::object();
+        res.set_header("Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
+        res.set_content(out.dump(2), "application/json; charset=utf-8");
+        });
+
     // --- API: bot settings ---
     // GET  /api/bot/settings  -> current safety settings (loaded from bot_settings.json)
     // POST /api/bot/settings  -> replace/update settings
@@ -2740,6 +3230,10 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
         out["ts_ms"] = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::system_clock::now().time_since_epoch()).count();
         out["settings"] = state_.bot_settings_json();
+        if (opt_.bot_reply_metrics_json) {
+            // Outbound queue depth, rate-limit waits and platform send windows.
+            out["outbound"] = opt_.bot_reply_metrics_json();
+        }
         res.set_header("Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
         res.set_header("Pragma", "no-cache");
         res.set_content(out.dump(2), "application/json; charset=utf-8");
@@ -2854,30 +3348,31 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
 // --- API: overlay header ---
 // GET  /api/overlay/header -> single flat response shape
 // POST /api/overlay/header -> set title/subtitle plus SimBrief/manual route fields
-    svr.Get("/api/overlay/header", [&](const httplib::Request&, httplib::Response& res) {
-        nlohmann::json persisted;
-        ReadOverlayHeaderJson(&persisted);
+    svr.Get("/api/overlay/header", [&](const httplib::Request& req, httplib::Response& res) {
+        ServeCachedJson(req, res, "overlay_header",
+            std::to_string(state_.version(AppState::Domain::OverlayHeader)), [this]() {
+                nlohmann::json persisted;
+                ReadOverlayHeaderJson(&persisted);
 
-        nlohmann::json header = state_.overlay_header_json();
-        if (!header.is_object()) header = nlohmann::json::object();
+                nlohmann::json header = state_.overlay_header_json();
+                if (!header.is_object()) header = nlohmann::json::object();
 
-        const bool use_simbrief = JsonBoolLoose(persisted, "use_simbrief", true);
-        const std::string manual_callsign = SanitizeOverlayCallsign(persisted.value("manual_callsign", ""));
-        const std::string manual_departure = SanitizeOverlayRouteText(persisted.value("manual_departure", ""));
-        const std::string manual_destination = SanitizeOverlayRouteText(persisted.value("manual_destination", ""));
-
-        nlohmann::json out;
-        out["ok"] = true;
-        out["title"] = header.value("title", "");
-        out["subtitle"] = header.value("subtitle", "");
-        out["use_simbrief"] = use_simbrief;
-        out["manual_callsign"] = manual_callsign;
-        out["manual_departure"] = manual_departure;
-        out["manual_destination"] = manual_destination;
+                const bool use_simbrief = JsonBoolLoose(persisted, "use_simbrief", true);
+                const std::string manual_callsign = SanitizeOverlayCallsign(persisted.value("manual_callsign", ""));
+                const std::string manual_departure = SanitizeOverlayRouteText(persisted.value("manual_departure", ""));
+                const std::string manual_destination = SanitizeOverlayRouteText(persisted.value("manual_destination", ""));
 
-        res.set_header("Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
-        res.set_header("Pragma", "no-cache");
-        res.set_content(out.dump(2), "application/json; charset=utf-8");
+                nlohmann::json out;
+                out["ok"] = true;
+                out["title"] = header.value("title", "");
+                out["subtitle"] = header.value("subtitle", "");
+                out["use_simbrief"] = use_simbrief;
+                out["manual_callsign"] = manual_callsign;
+                out["manual_departure"] = manual_departure;
+                out["manual_destination"] = manual_destination;
+
+                return out.dump(2);
+            });
         });
 
     svr.Post("/api/overlay/header", [&](const httplib::Request& req, httplib::Response& res) {
@@ -2939,6 +3434,8 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
             return;
         }
 
+        // The route fields live in overlay_header.json, outside AppState.
+        state_.bump_version(AppState::Domain::OverlayHeader);
         OverlayHttpLog(log_, L"Overlay header updated successfully");
 
         nlohmann::json out;
@@ -3218,9 +3715,18 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
                 // keep default
             }
         }
+        std::uint64_t since = 0;
+        if (req.has_param("since")) {
+            try { since = (std::uint64_t)std::stoull(req.get_param_value("since")); }
+            catch (...) {}
+        }
 
-        auto j = state_.tiktok_events_json(static_cast<size_t>(limit));
-        res.set_content(j.dump(2), "application/json; charset=utf-8");
+        const std::string query = std::to_string(since) + "," + std::to_string(limit);
+        // Each poller sends its own since= cursor: only the since=0 view is kept in the cache.
+        ServeCachedJson(req, res, "tiktok_events?" + query,
+            std::to_string(state_.version(AppState::Domain::TikTokEvents)), [this, limit, since]() {
+                return state_.tiktok_events_json(static_cast<size_t>(limit), since).dump(2);
+            }, since == 0);
         });
 
     // --- API: YouTube events ---
@@ -3230,21 +3736,30 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
             try { limit = std::max(1, std::min(1000, std::stoi(req.get_param_value("limit")))); }
             catch (...) {}
         }
+        std::uint64_t since = 0;
+        if (req.has_param("since")) {
+            try { since = (std::uint64_t)std::stoull(req.get_param_value("since")); }
+            catch (...) {}
+        }
 
-        json out;
-        out["ts_ms"] = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch()
-        ).count();
-        out["events"] = state_.youtube_events_json((size_t)limit);
-
-        res.set_header("Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
-        res.set_header("Pragma", "no-cache");
-        res.set_content(out.dump(2), "application/json; charset=utf-8");
+        // ts_ms is the build time of the cached body (i.e. when the event list last changed).
+        const std::string query = std::to_string(since) + "," + std::to_string(limit);
+        // Each poller sends its own since= cursor: only the since=0 view is kept in the cache.
+        ServeCachedJson(req, res, "youtube_events?" + query,
+            std::to_string(state_.version(AppState::Domain::YouTubeEvents)), [this, limit, since]() {
+                json out;
+                out["ts_ms"] = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()
+                ).count();
+                out["events"] = state_.youtube_events_json((size_t)limit, since);
+                return out.dump(2);
+            }, since == 0);
         });
 
 
     // --- API: Unified alerts history (missed alerts / replay tooling) ---
-    // GET /api/alerts/history?limit=200&platform=twitch|tiktok|youtube
+    // GET /api/alerts/history?limit=200&platform=twitch|tiktok|youtube&before=hist-123|after=hist-123
+    // Newest first. Page back with before=<next_before>; catch up with after=<latest_seq>.
     svr.Get("/api/alerts/history", [&](const httplib::Request& req, httplib::Response& res) {
         int limit = 200;
         if (req.has_param("limit")) {
@@ -3253,11 +3768,23 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
         }
         std::string platform;
         if (req.has_param("platform")) platform = req.get_param_value("platform");
-
-        auto j = state_.alerts_history_json(limit, platform);
-        res.set_header("Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
-        res.set_header("Pragma", "no-cache");
-        res.set_content(j.dump(2), "application/json; charset=utf-8");
+        std::transform(platform.begin(), platform.end(), platform.begin(),
+            [](unsigned char c) { return (char)std::tolower(c); });
+
+        std::uint64_t before = 0;
+        std::uint64_t after = 0;
+        if (req.has_param("before")) before = alerts::AlertHistoryStore::ParseHistoryId(req.get_param_value("before"));
+        if (req.has_param("after")) after = alerts::AlertHistoryStore::ParseHistoryId(req.get_param_value("after"));
+
+        // Only the default first page per platform is shared by pollers. Cursor pages, other
+        // limits and unknown platforms are one-offs and would only churn the shared cache.
+        const bool known_platform = platform.empty() || platform == "twitch" || platform == "tiktok" || platform == "youtube";
+        const bool cacheable = before == 0 && after == 0 && limit == 200 && known_platform;
+        ServeCachedJson(req, res,
+            "alerts_history?" + std::to_string(limit) + "," + platform + "," + std::to_string(before) + "," + std::to_string(after),
+            std::to_string(state_.version(AppState::Domain::AlertsHistory)), [this, limit, platform, before, after]() {
+                return state_.alerts_history_json(limit, platform, before, after);
+            }, cacheable);
         });
 
     // POST /api/alerts/resend  (localhost-only)
@@ -3330,33 +3857,14 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
 
 
     // --- Overlay: special chat.html injection ---
-    svr.Get("/overlay/chat.html", [&](const httplib::Request&, httplib::Response& res) {
+    svr.Get("/overlay/chat.html", [&](const httplib::Request& req, httplib::Response& res) {
         std::filesystem::path htmlPath = opt_.overlay_root / "common" / "chat.html";
-        auto html = ReadFileUtf8(htmlPath);
-        if (html.empty()) {
+        if (!ServeStaticFile(req, res, htmlPath, "chat.html")) {
             res.status = 404;
             res.set_header("Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
             res.set_header("Pragma", "no-cache");
             res.set_content("chat.html not found", "text/plain");
-            return;
-        }
-
-        std::string fontFamily = Trim(config_.overlay_font_family);
-        std::string fontStack = "sans-serif";
-        std::string googleLink;
-
-        if (!fontFamily.empty()) {
-            fontStack = "'" + fontFamily + "', sans-serif";
-            // Optional Google Fonts link injection if you use placeholders
-            googleLink = "<link rel=\"preconnect\" href=\"https://fonts.googleapis.com\">\n"
-                "<link rel=\"preconnect\" href=\"https://fonts.gstatic.com\" crossorigin>\n"
-                "<link href=\"https://fonts.googleapis.com/css2?family=" + fontFamily + ":wght@300;400;600;700&display=swap\" rel=\"stylesheet\">\n";
         }
-
-        std::string shadow = config_.overlay_text_shadow ? "0 2px 10px rgba(0,0,0,.55)" : "none";
-        ApplyOverlayTokens(html);
-
-        res.set_content(html, "text/html; charset=utf-8");
         });
 
     // /overlay or /overlay/ -> default (chat)
@@ -3385,18 +3893,11 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
         }
 
         std::filesystem::path p = opt_.overlay_root / rel;
-        if (!std::filesystem::exists(p) || std::filesystem::is_directory(p)) {
+        // HTML pages (overlay and app) get font/shadow/header token substitution.
+        if (!ServeStaticFile(req, res, p, rel)) {
             res.status = 404;
             res.set_content("not found", "text/plain");
-            return;
-        }
-
-        auto bytes = ReadFileUtf8(p);
-        // Apply overlay token substitution for HTML files
-        if (rel.size() >= 5 && rel.substr(rel.size() - 5) == ".html") {
-            ApplyOverlayTokens(bytes);
         }
-        res.set_content(std::move(bytes), ContentTypeFor(rel));
         });
 
     // --- Static assets: /assets/... ---
@@ -3425,18 +3926,11 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
         }
 
         std::filesystem::path p = assetsRoot / "app" / rel;
-        if (!std::filesystem::exists(p) || std::filesystem::is_directory(p)) {
+        // HTML pages (overlay and app) get font/shadow/header token substitution.
+        if (!ServeStaticFile(req, res, p, rel)) {
             res.status = 404;
             res.set_content("not found", "text/plain");
-            return;
-        }
-
-        auto bytes = ReadFileUtf8(p);
-        if (rel.size() >= 5 && rel.substr(rel.size() - 5) == ".html") {
-            // Allow token substitution for app pages too.
-            ApplyOverlayTokens(bytes);
         }
-        res.set_content(std::move(bytes), ContentTypeFor(rel));
         });
 
     svr.Get(R"(/assets/(.*))", [&, assetsRoot](const httplib::Request& req, httplib::Response& res) {
@@ -3450,18 +3944,11 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
         }
 
         std::filesystem::path p = assetsRoot / rel;
-        if (!std::filesystem::exists(p) || std::filesystem::is_directory(p)) {
+        // HTML pages (overlay and app) get font/shadow/header token substitution.
+        if (!ServeStaticFile(req, res, p, rel)) {
             res.status = 404;
             res.set_content("not found", "text/plain");
-            return;
-        }
-
-        auto bytes = ReadFileUtf8(p);
-        if (rel.size() >= 5 && rel.substr(rel.size() - 5) == ".html") {
-            // Reuse the same token logic for app pages (lets you apply font/shadow tokens if desired).
-            ApplyOverlayTokens(bytes);
         }
-        res.set_content(std::move(bytes), ContentTypeFor(rel));
         });
 
     // --- API: platform control (start/stop) ---
@@ -3507,6 +3994,9 @@ svr.Get("/api/twitch/eventsub/status", [&](const httplib::Request&, httplib::Res
                 return;
             }
 
+            // start_twitch sanitizes config_.twitch_login; hand the result to the supporter feed.
+            if (platform == "twitch" && action == "start" && supporters_) supporters_->SetTwitchLogin(config_.twitch_login);
+
             const std::string state = (action == "start") ? "started" : "stopped";
             state_.set_platform_runtime_state(platform, action == "start" ? "running" : "stopped");
             std::string body = std::string(R"({"ok":true,"platform":")") + platform +
@@ -7,15 +7,22 @@
 #include <functional>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <cstdint>
 
 #include "httplib.h"
 #include "json.hpp"
+#include "EventStreamHub.h"
+#include "HttpRouteStats.h"
+#include "ResponseCache.h"
+#include "StaticAssetCache.h"
 
 class AppState;
 class ChatAggregator;
 class EuroScopeIngestService;
 
 namespace simconnect { class SimConnectWorker; }
+namespace supporter { class SupporterFeedService; }
 struct AppConfig;
 
 // Simple embedded HTTP server that hosts API routes and overlay static files.
@@ -64,6 +71,9 @@ public:
         std::function<bool()> simulator_automation_enable;
         std::function<bool()> simulator_automation_disable;
         std::function<bool()> simulator_automation_panic;
+
+        // Bot outbound reply queue diagnostics (per-platform depth, failures, latency).
+        std::function<nlohmann::json()> bot_reply_metrics_json;
     };
 
     using LogFn = std::function<void(const std::wstring&)>;
@@ -83,6 +93,13 @@ public:
 private:
     void RegisterRoutes();
     void ApplyOverlayTokens(std::string& html);
+    // Names the inputs of ApplyOverlayTokens (header version, shadow) for the asset cache.
+    std::string OverlayTokenVariant() const;
+
+    // Serves a file from static_cache_ with ETag / 304 revalidation; .html files get overlay
+    // token substitution. Returns false (response untouched) when the file does not exist.
+    bool ServeStaticFile(const httplib::Request& req, httplib::Response& res,
+                         const std::filesystem::path& path, const std::string& rel);
 
     // --- SimBrief cache (used by /api/simbrief/flight) ---
     void StartSimBriefWorker();
@@ -92,6 +109,28 @@ private:
     void StartSimConnectWorker();
     void StopSimConnectWorker();
 
+    // --- /api/stream (Server-Sent Events push) ---
+    void StartStreamPump();
+    void StopStreamPump();
+
+    // /api/metrics payload (AppState metrics + EuroScope ingest snapshot).
+    nlohmann::json MetricsSnapshotJson() const;
+    // Change tag for MetricsSnapshotJson(); equal tags mean equal payloads.
+    std::string MetricsVersion() const;
+
+    // Serves a versioned JSON body: 304 when the client's If-None-Match is current, otherwise
+    // the cached bytes for `version` (built on a miss). See ResponseCache.
+    // With store=false the body is built per request and not kept: for cursor/coordinate queries
+    // whose keys are unbounded and would churn the cache, but still want ETag revalidation.
+    void ServeCachedJson(const httplib::Request& req, httplib::Response& res,
+                         const std::string& key, const std::string& version,
+                         const std::function<std::string()>& build, bool store = true);
+
+    // Post-routing hook: gzip negotiation (cached variant from ServeCachedJson/ServeStaticFile,
+    // otherwise on-the-fly above kGzipMinBytes) and per-route byte counters.
+    void FinishResponse(const httplib::Request& req, httplib::Response& res);
+    static constexpr std::size_t kGzipMinBytes = 1400; // roughly one TCP segment
+
     AppState& state_;
     ChatAggregator& chat_;
     EuroScopeIngestService& euroscope_;
@@ -108,6 +147,24 @@ private:
 
     std::unique_ptr<simconnect::SimConnectWorker> simconnect_;
 
+    // Background-refreshed /api/supporters/recent list (Helix + YouTube members).
+    std::unique_ptr<supporter::SupporterFeedService> supporters_;
+
+    // SSE fan-out. The pump thread turns chat notifications into cursor pulls and
+    // publishes metrics deltas; alerts are published directly from the support event bus.
+    EventStreamHub stream_;
+    std::thread stream_thread_;
+    std::atomic<bool> stream_stop_{ false };
+    std::mutex stream_mu_;
+    std::condition_variable stream_cv_;
+    bool stream_chat_dirty_ = false;
+    std::uint64_t stream_chat_sub_id_ = 0;
+    std::uint64_t stream_support_sub_id_ = 0;
+
+    ResponseCache response_cache_;
+    StaticAssetCache static_cache_;
+    HttpRouteStats route_stats_;
+
     std::unique_ptr<httplib::Server> svr_;
     std::thread thread_;
 };
\ No newline at end of file
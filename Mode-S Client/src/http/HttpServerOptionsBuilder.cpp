@@ -6,6 +6,7 @@
 
 #include "AppConfig.h"
 #include "AppState.h"
+#include "bot/BotCommandDispatcher.h"
 #include "chat/ChatAggregator.h"
 #include "core/StringUtil.h"
 #include "json.hpp"
@@ -283,6 +284,10 @@ HttpServer::Options BuildHttpServerOptions(
         return true;
     };
 
+    opt.bot_reply_metrics_json = []() {
+        return bot::BotReplyQueueMetricsJson();
+    };
+
     return opt;
 }
 
@@ -0,0 +1,71 @@
+#include "http/ResponseCache.h"
+#include "http/GzipEncoder.h"
+
+#include <chrono>
+#include <cstdio>
+
+ResponseCache::ResponseCache()
+{
+    const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%llx", (unsigned long long)now);
+    boot_id_ = buf;
+}
+
+std::shared_ptr<const ResponseCache::Body> ResponseCache::Get(const std::string& key,
+                                                              const std::string& version,
+                                                              const std::function<std::string()>& build)
+{
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = slots_.find(key);
+        if (it != slots_.end() && it->second.version == version && it->second.body) {
+            return it->second.body;
+        }
+    }
+
+    // Concurrent misses may both build; the bodies are identical, so last writer wins.
+    auto built = std::make_shared<Body>();
+    built->bytes = build();
+    if (built->bytes.size() >= kMinGzipBytes) {
+        std::string z = gzip::Compress(built->bytes);
+        if (z.size() < built->bytes.size()) built->gzip = std::move(z);
+    }
+    std::shared_ptr<const Body> body = std::move(built);
+
+    std::lock_guard<std::mutex> lock(mu_);
+    if (slots_.size() >= kMaxSlots && slots_.find(key) == slots_.end()) {
+        slots_.clear();
+    }
+    slots_[key] = Slot{ version, body };
+    return body;
+}
+
+std::string ResponseCache::ETag(const std::string& key, const std::string& version) const
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%zx", std::hash<std::string>{}(key));
+    return "\"" + boot_id_ + "-" + buf + "-" + version + "\"";
+}
+
+bool ResponseCache::IfNoneMatch(const std::string& header_value, const std::string& etag)
+{
+    size_t start = 0;
+    while (start < header_value.size()) {
+        size_t comma = header_value.find(',', start);
+        if (comma == std::string::npos) comma = header_value.size();
+
+        size_t b = start;
+        size_t e = comma;
+        while (b < e && (header_value[b] == ' ' || header_value[b] == '\t')) ++b;
+        while (e > b && (header_value[e - 1] == ' ' || header_value[e - 1] == '\t')) --e;
+        if (e - b >= 2 && header_value.compare(b, 2, "W/") == 0) b += 2;
+
+        if (e - b == 1 && header_value[b] == '*') return true;
+        if (header_value.compare(b, e - b, etag) == 0) return true;
+
+        start = comma + 1;
+    }
+    return false;
+}
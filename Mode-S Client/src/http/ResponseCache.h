@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Version-keyed cache of serialized JSON responses for the polled endpoints.
+//
+// A caller describes its data with a version string built from change counters (AppState
+// domain versions, EuroScope ingest version, query parameters). While the version is unchanged
+// every poller gets the same bytes; a changed version rebuilds the body once. ETags carry a
+// per-process boot id so counters restarting at 0 never validate a previous run's copy.
+// Bodies large enough to benefit are gzip-encoded once per version, next to the raw bytes.
+class ResponseCache {
+public:
+    struct Body {
+        std::string bytes;
+        std::string gzip; // empty when below kMinGzipBytes or not smaller
+    };
+
+    ResponseCache();
+
+    // Body for `key` at `version`; `build` runs (outside the lock) on a miss.
+    std::shared_ptr<const Body> Get(const std::string& key,
+                                           const std::string& version,
+                                           const std::function<std::string()>& build);
+
+    // Strong ETag for a (key, version) pair, quotes included.
+    std::string ETag(const std::string& key, const std::string& version) const;
+
+    // True when an If-None-Match header value matches `etag` (handles lists, W/ and "*").
+    static bool IfNoneMatch(const std::string& header_value, const std::string& etag);
+
+private:
+    struct Slot {
+        std::string version;
+        std::shared_ptr<const Body> body;
+    };
+
+    static constexpr std::size_t kMinGzipBytes = 1024;
+
+    // Distinct keys come from query variants (limit/since); drop everything past this.
+    static constexpr std::size_t kMaxSlots = 256;
+
+    std::string boot_id_;
+    std::mutex mu_;
+    std::unordered_map<std::string, Slot> slots_;
+};
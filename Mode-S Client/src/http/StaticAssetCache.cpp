@@ -0,0 +1,124 @@
+#include "http/StaticAssetCache.h"
+#include "http/GzipEncoder.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+std::string StaticAssetCache::ReadFile(const std::filesystem::path& p)
+{
+    std::ifstream f(p, std::ios::binary);
+    if (!f) return {};
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+void StaticAssetCache::BuildGzip(Asset& a)
+{
+    if (a.bytes.size() < kMinGzipBytes) return;
+    std::string z = gzip::Compress(a.bytes);
+    if (z.size() < a.bytes.size()) a.gzip = std::move(z);
+}
+
+std::string StaticAssetCache::MakeETag(std::uintmax_t size, std::filesystem::file_time_type mtime, const std::string& variant)
+{
+    char buf[96];
+    std::snprintf(buf, sizeof(buf), "\"%llx-%llx-%zx\"",
+        (unsigned long long)size,
+        (unsigned long long)mtime.time_since_epoch().count(),
+        std::hash<std::string>{}(variant));
+    return buf;
+}
+
+std::shared_ptr<const StaticAssetCache::Asset> StaticAssetCache::Get(const std::filesystem::path& path,
+                                                                     const std::string& variant,
+                                                                     const Transform& transform,
+                                                                     bool compress)
+{
+    const std::string key = path.string();
+    const auto now = std::chrono::steady_clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = entries_.find(key);
+        if (it != entries_.end() &&
+            now - it->second.checked < std::chrono::milliseconds(kRevalidateMs)) {
+            Entry& e = it->second;
+            if (!transform) return e.raw;
+            if (e.variant && e.variant_key == variant) return e.variant;
+        }
+    }
+
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(path, ec) || ec) {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = entries_.find(key);
+        if (it != entries_.end()) {
+            total_bytes_ -= it->second.size;
+            entries_.erase(it);
+        }
+        return nullptr;
+    }
+    const auto mtime = std::filesystem::last_write_time(path, ec);
+    const auto size = ec ? 0 : std::filesystem::file_size(path, ec);
+
+    auto build_variant = [&](const Asset& raw) {
+        auto v = std::make_shared<Asset>();
+        v->bytes = raw.bytes;
+        transform(v->bytes);
+        v->etag = MakeETag(size, mtime, variant);
+        if (compress) BuildGzip(*v);
+        return std::shared_ptr<const Asset>(std::move(v));
+    };
+
+    std::shared_ptr<const Asset> raw;
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        auto it = entries_.find(key);
+        if (it != entries_.end() && !ec && it->second.mtime == mtime && it->second.size == size) {
+            it->second.checked = now;
+            raw = it->second.raw;
+            if (!transform) return raw;
+            if (it->second.variant && it->second.variant_key == variant) return it->second.variant;
+        }
+    }
+
+    if (!raw) {
+        auto a = std::make_shared<Asset>();
+        a->bytes = ReadFile(path);
+        a->etag = MakeETag(size, mtime, std::string());
+        // A transformed request only serves the variant, so only that one gets compressed.
+        if (compress && !transform) BuildGzip(*a);
+        raw = std::move(a);
+    }
+
+    std::shared_ptr<const Asset> result = transform ? build_variant(*raw) : raw;
+
+    if (ec || size > kMaxFileBytes) return result;
+
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.mtime != mtime || it->second.size != size) {
+        if (it != entries_.end()) {
+            total_bytes_ -= it->second.size;
+            entries_.erase(it);
+        }
+        if (total_bytes_ + size > kMaxTotalBytes) {
+            entries_.clear();
+            total_bytes_ = 0;
+        }
+        Entry e;
+        e.mtime = mtime;
+        e.size = size;
+        e.raw = raw;
+        it = entries_.emplace(key, std::move(e)).first;
+        total_bytes_ += size;
+    }
+    it->second.checked = now;
+    if (transform) {
+        it->second.variant_key = variant;
+        it->second.variant = result;
+    }
+    return result;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// In-memory cache for the files served under /overlay, /app and /assets.
+//
+// Entries hold the raw bytes plus one transformed variant (overlay token substitution), each
+// with a gzip copy when the file is text and large enough to benefit. A
+// file's size and mtime are re-checked at most once per kRevalidateMs, so a burst of OBS
+// browser-source reloads is served from memory while edits on disk still show up within a
+// second. The transformed variant is rebuilt when its `variant` key (header version, font
+// and shadow settings) changes.
+class StaticAssetCache {
+public:
+    struct Asset {
+        std::string bytes;
+        std::string etag; // strong, quotes included
+        std::string gzip; // gzip-encoded `bytes`; empty when not compressible or not smaller
+    };
+
+    using Transform = std::function<void(std::string&)>;
+
+    // nullptr when the file is missing or a directory. `transform` may be empty (raw file).
+    // `compress` asks for the gzip copy (text content types only).
+    std::shared_ptr<const Asset> Get(const std::filesystem::path& path,
+                                     const std::string& variant,
+                                     const Transform& transform,
+                                     bool compress);
+
+private:
+    struct Entry {
+        std::filesystem::file_time_type mtime{};
+        std::uintmax_t size = 0;
+        std::chrono::steady_clock::time_point checked{};
+        std::shared_ptr<const Asset> raw;
+        std::string variant_key;
+        std::shared_ptr<const Asset> variant;
+    };
+
+    static constexpr std::int64_t kRevalidateMs = 1000;
+    static constexpr std::uintmax_t kMaxFileBytes = 8u * 1024u * 1024u; // larger files bypass the cache
+    static constexpr std::size_t kMaxTotalBytes = 96u * 1024u * 1024u;
+    static constexpr std::size_t kMinGzipBytes = 1024; // below this the header overhead wins
+
+    static std::string ReadFile(const std::filesystem::path& p);
+    static void BuildGzip(Asset& a);
+    static std::string MakeETag(std::uintmax_t size, std::filesystem::file_time_type mtime, const std::string& variant);
+
+    std::mutex mu_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::size_t total_bytes_ = 0;
+};
@@ -0,0 +1,89 @@
+#include "log/LogRing.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+std::size_t RoundUpPow2(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+} // namespace
+
+LogRing::SlotLock::SlotLock(const Slot& s) : s_(s) {
+    // Held for one string move/copy; contention only when the ring wraps onto a busy slot.
+    int spins = 0;
+    while (s_.busy.exchange(true, std::memory_order_acquire)) {
+        if (++spins > 64) std::this_thread::yield();
+    }
+}
+
+LogRing::SlotLock::~SlotLock() {
+    s_.busy.store(false, std::memory_order_release);
+}
+
+LogRing::LogRing(std::size_t capacity) {
+    Reset(capacity);
+}
+
+void LogRing::Reset(std::size_t capacity) {
+    const std::size_t n = RoundUpPow2(std::max<std::size_t>(capacity, 16));
+    slots_.reset(new Slot[n]);
+    mask_ = n - 1;
+    next_id_.store(0, std::memory_order_release);
+}
+
+std::uint64_t LogRing::Append(std::string msg, std::int64_t ts_ms) {
+    const std::uint64_t id = next_id_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    Slot& s = slots_[id & mask_];
+
+    SlotLock lock(s);
+    // A writer a full lap ahead may already own this slot; the older line is out of the window.
+    if (s.id < id) {
+        s.id = id;
+        s.ts_ms = ts_ms;
+        s.msg = std::move(msg);
+    }
+    return id;
+}
+
+nlohmann::json LogRing::Json(std::uint64_t since, int limit) const {
+    limit = std::max(1, std::min(limit, 1000));
+
+    const std::uint64_t last = next_id_.load(std::memory_order_acquire);
+    const std::uint64_t cap = (std::uint64_t)mask_ + 1;
+    const std::uint64_t oldest = last >= cap ? last - cap + 1 : 1;
+
+    // When no cursor is supplied yet, return the most recent `limit` entries,
+    // but keep them in oldest -> newest order within that window.
+    std::uint64_t from = 0;
+    if (since == 0) {
+        from = last >= (std::uint64_t)limit ? last - (std::uint64_t)limit + 1 : 1;
+    }
+    else {
+        from = since + 1;
+    }
+    from = std::max(from, oldest);
+    const std::uint64_t to = std::min(last, from + (std::uint64_t)limit - 1);
+
+    nlohmann::json arr = nlohmann::json::array();
+    for (std::uint64_t id = from; id <= to && last > 0; ++id) {
+        const Slot& s = slots_[id & mask_];
+        SlotLock lock(s);
+        if (s.id < id) break;      // claimed but not written yet; the next poll picks it up
+        if (s.id > id) continue;   // already overwritten by a newer lap
+        arr.push_back({
+            {"id", s.id},
+            {"ts_ms", s.ts_ms},
+            {"msg", s.msg}
+            });
+    }
+
+    nlohmann::json out;
+    out["ok"] = true;
+    out["entries"] = std::move(arr);
+    return out;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "json.hpp"
+
+// Fixed-capacity ring of log lines for the Web UI (/api/log).
+//
+// Capacity is a power of two and ids are contiguous (1, 2, 3, ...), so the line with id N lives
+// in slot N & mask: a `since` cursor is a direct index, not a scan. Appending takes no shared
+// lock: a writer claims an id with one atomic increment and then briefly owns only its slot.
+// Readers stop at the first slot whose writer has not finished yet, so an incremental reader
+// never skips a line.
+class LogRing {
+public:
+    explicit LogRing(std::size_t capacity);
+
+    // Reallocates (and clears) the ring. Not safe against concurrent Append/Json; call during
+    // startup before the ring is shared.
+    void Reset(std::size_t capacity);
+
+    std::uint64_t Append(std::string msg, std::int64_t ts_ms);
+
+    // {"ok":true,"entries":[{"id","ts_ms","msg"}...]} oldest -> newest. With since == 0 the
+    // newest `limit` lines; otherwise up to `limit` lines with id > since.
+    nlohmann::json Json(std::uint64_t since, int limit) const;
+
+    std::size_t capacity() const { return mask_ + 1; }
+    std::uint64_t last_id() const { return next_id_.load(std::memory_order_acquire); }
+
+private:
+    struct Slot {
+        mutable std::atomic<bool> busy{ false };
+        std::uint64_t id = 0; // 0: never written
+        std::int64_t ts_ms = 0;
+        std::string msg;
+    };
+
+    class SlotLock {
+    public:
+        explicit SlotLock(const Slot& s);
+        ~SlotLock();
+    private:
+        const Slot& s_;
+    };
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_ = 0;
+    std::atomic<std::uint64_t> next_id_{ 0 }; // last id handed out
+};
@@ -266,7 +266,7 @@ namespace PlatformControl {
 
         _wputenv_s(L"WHITELIST_AUTHENTICATED_SESSION_ID_HOST", L"tiktok.eulerstream.com");
 
-        bool ok = tiktok.start(L"python", sidecarPath, [log, &state, &chat](const json& j) {
+        bool ok = tiktok.start(L"python", sidecarPath, [log, &state, &chat, room = cleaned](const json& j) {
             std::string type = j.value("type", "");
             std::string msg = j.value("message", "");
             if (type == "tiktok.send_result" && log) {
@@ -312,6 +312,7 @@ namespace PlatformControl {
             else if (type == "tiktok.chat") {
                 ChatMessage c;
                 c.platform = "tiktok";
+                c.channel = room;
                 c.user = j.value("user", "unknown");
                 c.message = j.value("message", "");
                 double ts = j.value("ts", 0.0);
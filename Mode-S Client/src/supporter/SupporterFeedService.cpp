@@ -1,6 +1,7 @@
 #include "supporter/SupporterFeedService.h"
 
 #include <algorithm>
+#include <iterator>
 
 #include "AppState.h"
 #include "supporter/RecentSupporter.h"
@@ -9,6 +10,27 @@
 
 namespace supporter {
 
+namespace {
+
+bool NewerFirst(const RecentSupporter& a, const RecentSupporter& b) {
+    if (a.supported_at_ms != b.supported_at_ms) return a.supported_at_ms > b.supported_at_ms;
+    if (a.platform != b.platform) return a.platform < b.platform;
+    return a.display_name < b.display_name;
+}
+
+// A failed request keeps the last good list (with the new error) instead of blanking the
+// overlay; a source that is no longer connected (token removed, login cleared) is dropped.
+void UpdateSource(FetchResult& current, FetchResult next) {
+    if (!next.status.ok && next.status.connected && next.items.empty() && !current.items.empty()) {
+        current.status = std::move(next.status);
+        current.status.item_count = static_cast<int>(current.items.size());
+        return;
+    }
+    current = std::move(next);
+}
+
+} // namespace
+
 SupporterFeedService::SupporterFeedService(AppState& state,
                                            std::string twitch_login,
                                            AccessTokenFn twitch_access_token,
@@ -17,42 +39,156 @@ SupporterFeedService::SupporterFeedService(AppState& state,
                                            StringFn youtube_channel_id,
                                            LogFn log)
     : state_(state)
-    , twitch_login_(std::move(twitch_login))
     , twitch_access_token_(std::move(twitch_access_token))
     , twitch_client_id_(std::move(twitch_client_id))
     , youtube_access_token_(std::move(youtube_access_token))
     , youtube_channel_id_(std::move(youtube_channel_id))
-    , log_(std::move(log)) {
+    , log_(std::move(log))
+    , twitch_login_(std::move(twitch_login)) {
 }
 
-FeedResult SupporterFeedService::FetchRecent(int limit) const {
-    if (limit <= 0) limit = 16;
+SupporterFeedService::~SupporterFeedService() {
+    Stop();
+}
 
-    twitch::TwitchSupporterProvider twitch_provider(state_, twitch_login_, twitch_access_token_, twitch_client_id_, log_);
-    youtube::YouTubeSupporterProvider youtube_provider(youtube_access_token_, youtube_channel_id_, log_);
+void SupporterFeedService::Start() {
+    if (thread_.joinable()) return;
+    stop_.store(false);
+    thread_ = std::thread([this]() { Run(); });
+}
 
-    FetchResult twitch = twitch_provider.FetchRecent(limit);
-    FetchResult youtube = youtube_provider.FetchRecent(limit);
+void SupporterFeedService::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mu_);
+        stop_.store(true);
+    }
+    cv_.notify_all();
+    ready_cv_.notify_all();
+    if (thread_.joinable()) thread_.join();
+}
 
-    FeedResult out;
-    out.twitch = twitch.status;
-    out.youtube = youtube.status;
+std::uint64_t SupporterFeedService::Poll(int limit) {
+    limit = std::clamp(limit, 1, kMaxLimit);
+    const auto now = std::chrono::steady_clock::now();
 
-    out.items.reserve(twitch.items.size() + youtube.items.size());
-    out.items.insert(out.items.end(), twitch.items.begin(), twitch.items.end());
-    out.items.insert(out.items.end(), youtube.items.begin(), youtube.items.end());
+    std::unique_lock<std::mutex> lock(mu_);
+    last_poll_ = now;
+    want_limit_ = std::max(want_limit_, limit);
 
-    std::sort(out.items.begin(), out.items.end(), [](const RecentSupporter& a, const RecentSupporter& b) {
-        if (a.supported_at_ms != b.supported_at_ms) return a.supported_at_ms > b.supported_at_ms;
-        if (a.platform != b.platform) return a.platform < b.platform;
-        return a.display_name < b.display_name;
-    });
+    const bool stale = generation_ == 0 ||
+        limit > fetched_limit_ ||
+        now - last_refresh_ >= std::chrono::milliseconds(kRefreshMs);
+    if (stale && !refreshing_ && !refresh_requested_) {
+        refresh_requested_ = true;
+        cv_.notify_all();
+    }
 
-    if (static_cast<int>(out.items.size()) > limit) {
-        out.items.resize(static_cast<size_t>(limit));
+    if (generation_ == 0) {
+        ready_cv_.wait_for(lock, std::chrono::milliseconds(kColdStartWaitMs), [this]() {
+            return generation_ != 0 || stop_.load();
+        });
     }
+    return generation_;
+}
+
+void SupporterFeedService::SetTwitchLogin(std::string login) {
+    std::lock_guard<std::mutex> lock(mu_);
+    twitch_login_ = std::move(login);
+}
 
+FeedResult SupporterFeedService::Recent(int limit) const {
+    limit = std::clamp(limit, 1, kMaxLimit);
+
+    std::lock_guard<std::mutex> lock(mu_);
+    FeedResult out;
+    out.twitch = twitch_.status;
+    out.youtube = youtube_.status;
+
+    const size_t n = std::min(merged_.size(), static_cast<size_t>(limit));
+    out.items.assign(merged_.begin(), merged_.begin() + static_cast<std::ptrdiff_t>(n));
     return out;
 }
 
+void SupporterFeedService::SortNewestFirst(std::vector<RecentSupporter>& items) {
+    // Providers already return newest first (EventSub replayed backwards, Helix rows at 0,
+    // members.list in join order), so this is normally just the O(n) check.
+    if (!std::is_sorted(items.begin(), items.end(), NewerFirst)) {
+        std::stable_sort(items.begin(), items.end(), NewerFirst);
+    }
+}
+
+void SupporterFeedService::Run() {
+    std::unique_lock<std::mutex> lock(mu_);
+    while (!stop_.load()) {
+        const auto now = std::chrono::steady_clock::now();
+        const bool active = generation_ != 0 &&
+            now - last_poll_ < std::chrono::milliseconds(kIdleAfterMs);
+        const bool due = refresh_requested_ ||
+            (active && now - last_refresh_ >= std::chrono::milliseconds(kRefreshMs));
+
+        if (!due) {
+            cv_.wait_for(lock, std::chrono::milliseconds(kRefreshMs));
+            continue;
+        }
+
+        refresh_requested_ = false;
+        refreshing_ = true;
+        const int limit = want_limit_;
+
+        lock.unlock();
+        Refresh(limit);
+        lock.lock();
+
+        refreshing_ = false;
+        ready_cv_.notify_all();
+    }
+}
+
+void SupporterFeedService::Refresh(int limit) {
+    FetchResult twitch;
+    FetchResult youtube;
+
+    try {
+        std::string login;
+        {
+            std::lock_guard<std::mutex> lock(mu_);
+            login = twitch_login_;
+        }
+        twitch::TwitchSupporterProvider twitch_provider(state_, login, twitch_access_token_, twitch_client_id_, log_);
+        twitch = twitch_provider.FetchRecent(limit);
+    }
+    catch (...) {
+        twitch.status.connected = true;
+        twitch.status.error = "twitch supporter fetch failed";
+    }
+
+    try {
+        youtube::YouTubeSupporterProvider youtube_provider(youtube_access_token_, youtube_channel_id_, log_);
+        youtube = youtube_provider.FetchRecent(limit);
+    }
+    catch (...) {
+        youtube.status.connected = true;
+        youtube.status.error = "youtube supporter fetch failed";
+    }
+
+    SortNewestFirst(twitch.items);
+    SortNewestFirst(youtube.items);
+
+    std::lock_guard<std::mutex> lock(mu_);
+    UpdateSource(twitch_, std::move(twitch));
+    UpdateSource(youtube_, std::move(youtube));
+
+    // Both sources are newest first, so one linear merge replaces the old concat + sort.
+    std::vector<RecentSupporter> merged;
+    merged.reserve(twitch_.items.size() + youtube_.items.size());
+    std::merge(twitch_.items.begin(), twitch_.items.end(),
+        youtube_.items.begin(), youtube_.items.end(),
+        std::back_inserter(merged), NewerFirst);
+    merged_.swap(merged);
+
+    fetched_limit_ = limit;
+    last_refresh_ = std::chrono::steady_clock::now();
+    ++generation_;
+}
+
 } // namespace supporter
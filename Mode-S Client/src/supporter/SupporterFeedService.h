@@ -1,8 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "supporter/RecentSupporter.h"
 
@@ -10,12 +17,20 @@ class AppState;
 
 namespace supporter {
 
+// Recent supporters across Twitch and YouTube, served from memory.
+//
+// A background thread pages through the provider APIs and keeps one merged, newest-first list.
+// Requests never wait on the network (except the very first one, briefly): a stale list is
+// returned immediately and a refresh is scheduled behind it (stale-while-revalidate). The
+// refresher only runs while overlays are actually polling.
 class SupporterFeedService {
 public:
     using AccessTokenFn = std::function<std::optional<std::string>()>;
     using StringFn = std::function<std::optional<std::string>()>;
     using LogFn = std::function<void(const std::wstring&)>;
 
+    // `twitch_login` is copied; the HTTP settings handlers push later changes via SetTwitchLogin()
+    // so the refresher thread never reads AppConfig.
     SupporterFeedService(AppState& state,
                          std::string twitch_login,
                          AccessTokenFn twitch_access_token,
@@ -23,17 +38,67 @@ public:
                          AccessTokenFn youtube_access_token,
                          StringFn youtube_channel_id,
                          LogFn log);
+    ~SupporterFeedService();
 
-    FeedResult FetchRecent(int limit) const;
+    SupporterFeedService(const SupporterFeedService&) = delete;
+    SupporterFeedService& operator=(const SupporterFeedService&) = delete;
+
+    void Start();
+    void Stop();
+
+    // Used by the next refresh.
+    void SetTwitchLogin(std::string login);
+
+    // Records demand for `limit` items and schedules a refresh when the list is older than
+    // kRefreshMs (or shorter than `limit`). Only blocks, for at most kColdStartWaitMs, while no
+    // fetch has completed yet. Returns the list generation, which changes on every refresh.
+    std::uint64_t Poll(int limit);
+
+    // The newest `limit` items of the cached list; O(limit), never touches the network.
+    FeedResult Recent(int limit) const;
+
+    // Request limits are clamped to [1, kMaxLimit]; kMaxLimit is also the most one refresh pages
+    // through per provider.
+    static constexpr int kDefaultLimit = 16;
+    static constexpr int kMaxLimit = 100;
 
 private:
+    void Run();
+    void Refresh(int limit);
+
+    static void SortNewestFirst(std::vector<RecentSupporter>& items);
+
     AppState& state_;
-    std::string twitch_login_;
     AccessTokenFn twitch_access_token_;
     StringFn twitch_client_id_;
     AccessTokenFn youtube_access_token_;
     StringFn youtube_channel_id_;
     LogFn log_;
+
+    static constexpr std::int64_t kRefreshMs = 30 * 1000;
+    static constexpr std::int64_t kIdleAfterMs = 5 * 60 * 1000; // stop refreshing without pollers
+    static constexpr std::int64_t kColdStartWaitMs = 8000;
+
+    mutable std::mutex mu_;
+    std::condition_variable cv_;       // wakes the refresher
+    std::condition_variable ready_cv_; // wakes cold-start pollers
+    std::thread thread_;
+    std::atomic<bool> stop_{ true };
+
+    // Guarded by mu_.
+    std::string twitch_login_;
+    bool refresh_requested_ = false;
+    bool refreshing_ = false;
+    int want_limit_ = kDefaultLimit;
+    int fetched_limit_ = 0;
+    std::uint64_t generation_ = 0;
+    std::chrono::steady_clock::time_point last_refresh_{};
+    std::chrono::steady_clock::time_point last_poll_{};
+
+    // Per-source lists (each newest first) and their merge.
+    FetchResult twitch_;
+    FetchResult youtube_;
+    std::vector<RecentSupporter> merged_;
 };
 
 } // namespace supporter